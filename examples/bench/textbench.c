@@ -0,0 +1,154 @@
+/*-----------------------------------------------------------------------------
+--  Help ToolKit for Motif benchmark of the compound string converters
+-- 
+--  Copyright (c) 1997-2000, 2019 Robert S. Werner (a.k.a. Akiva Werner)  
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+-----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <Xm/Xm.h>
+#include <Xm/PushB.h>
+
+#include <Xsc/Help.h>
+#include <Xsc/Tip.h>
+
+#include "TipP.h"
+
+/*----------------------------------------------------------------------
+-- Each topic is converted this many times; the average is reported
+----------------------------------------------------------------------*/
+#define REPEAT 200
+
+/*---------------------------------------------------------------------
+-- This function makes a topic with the given number of lines.  Every
+-- line also changes the font, which adds a segment for the segmented
+-- converter.
+---------------------------------------------------------------------*/
+static char* makeTopic( int lines, Boolean escapes )
+{
+   char* topic = XtMalloc( lines * 48 + 1 );
+   char* p     = topic;
+   int   i;
+
+   *p = '\0';
+   for (i = 0; i < lines; i++)
+   {
+      if (escapes)
+      {
+         sprintf( p, "@f[%s]Line %d of the topic text\n", 
+                  (i & 1) ? "bold" : "", i );
+      }
+      else
+      {
+         sprintf( p, "Line %d of the topic text\n", i );
+      }
+      p += strlen( p );
+   }
+   return topic;
+}
+
+
+static double elapsed( struct timeval* start, struct timeval* end )
+{
+   return (end->tv_sec  - start->tv_sec ) * 1e6 + 
+          (end->tv_usec - start->tv_usec);
+}
+
+
+/*-------------------------------------------------------------------
+-- This function times one converter over a topic of 'lines' lines.
+-- Setting the topic only marks the text to be converted when it is
+-- next needed, so its width is asked for to force the conversion.
+-- The text takes over the font list tag, so a new copy is passed on
+-- every pass.
+-------------------------------------------------------------------*/
+static void run( 
+   Widget        button, 
+   XmFontList    font_list, 
+   unsigned char converter, 
+   const char*   name, 
+   int           lines )
+{
+   struct timeval start, end;
+   char*          topic;
+   int            i;
+   XscTip         tip;
+
+   topic = makeTopic( lines, converter == XmXSC_STRING_CONVERTER_SEGMENTED );
+
+   gettimeofday( &start, NULL );
+   for (i = 0; i < REPEAT; i++)
+   {
+      XscHelpSetTipTopicDetails( 
+         button, 
+         topic, 
+         font_list, 
+         XtNewString( XmFONTLIST_DEFAULT_TAG ),
+         XmALIGNMENT_BEGINNING,
+         XmSTRING_DIRECTION_L_TO_R,
+         converter );
+
+      tip = XscTipDeriveFromWidget( button );
+      _XscTextGetWidth( _XscTipGetText( tip ) );
+   }
+   gettimeofday( &end, NULL );
+
+   printf( "%-10s %5d lines %12.1f usec\n", 
+           name, lines, elapsed( &start, &end ) / REPEAT );
+
+   XtFree( topic );
+}
+
+
+int main( argc, argv )
+   int    argc;
+   char** argv;
+{
+   static int   lines[] = { 1, 10, 100, 1000 };
+   XtAppContext app_context;
+   Widget       toplevel, button;
+   XFontStruct* font;
+   XmFontList   font_list;
+   int          i;
+
+   toplevel = XtAppInitialize( 
+      &app_context, 
+      "TextBench", 
+      NULL,    0,
+      &argc,   argv,
+      NULL, 
+      NULL,    (Cardinal)0 );
+
+   XscHelpInstall( toplevel );
+
+   button = XtVaCreateManagedWidget( 
+      "button", xmPushButtonWidgetClass, toplevel, NULL );
+
+   font = XLoadQueryFont( XtDisplay( toplevel ), "fixed" );
+   if (!font)
+   {
+      fprintf( stderr, "textbench: cannot load the \"fixed\" font\n" );
+      return 1;
+   }
+   font_list = XmFontListCreate( font, XmFONTLIST_DEFAULT_TAG );
+
+   for (i = 0; i < XtNumber( lines ); i++)
+   {
+      run( button, font_list, XmXSC_STRING_CONVERTER_FONT_TAG, 
+           "font-tag", lines[ i ] );
+   }
+   for (i = 0; i < XtNumber( lines ); i++)
+   {
+      run( button, font_list, XmXSC_STRING_CONVERTER_SEGMENTED, 
+           "segmented", lines[ i ] );
+   }
+
+   XmFontListFree( font_list );
+   return 0;
+}
@@ -0,0 +1,108 @@
+/*-----------------------------------------------------------------------------
+--  Help ToolKit for Motif benchmark of the topic file loader
+--
+--  Copyright (c) 1997-2000, 2019 Robert S. Werner (a.k.a. Akiva Werner)
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+-----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#include <X11/Xlib.h>
+#include <X11/Xresource.h>
+
+#include <Xsc/Help.h>
+
+/*----------------------------------------------------------------------
+-- The number of topics written, unless given on the command line, and
+-- the number of text lines in each of them
+----------------------------------------------------------------------*/
+#define TOPICS 100000
+#define LINES  5
+
+
+/*---------------------------------------------------------------------
+-- This function writes a topic file with the given number of topics
+---------------------------------------------------------------------*/
+static int makeTopicFile( char* path, int topics )
+{
+   FILE* file;
+   int   fd;
+   int   i, j;
+
+   fd = mkstemp( path );
+   if (fd < 0)
+   {
+      return 0;
+   }
+
+   file = fdopen( fd, "w" );
+   for (i = 0; i < topics; i++)
+   {
+      fprintf( file, ".TEXT[ topic%d ]\n", i );
+      for (j = 0; j < LINES; j++)
+      {
+         fprintf( file, "@f[bold]Line %d@f[] of topic %d, with some text.\n",
+                  j, i );
+      }
+      fprintf( file, ".END\n" );
+   }
+   fclose( file );
+   return 1;
+}
+
+
+static double elapsed( struct timeval* start, struct timeval* end )
+{
+   return (end->tv_sec  - start->tv_sec ) * 1e6 +
+          (end->tv_usec - start->tv_usec);
+}
+
+
+int main( argc, argv )
+   int    argc;
+   char** argv;
+{
+   char           path[] = "/tmp/topicbenchXXXXXX";
+   struct timeval start, end;
+   Display*       display;
+   int            topics;
+   int            result;
+
+   topics = (argc > 1) ? atoi( argv[ 1 ] ) : TOPICS;
+
+   display = XOpenDisplay( NULL );
+   if (!display)
+   {
+      fprintf( stderr, "topicbench: cannot open the display\n" );
+      return 1;
+   }
+
+   if (!makeTopicFile( path, topics ))
+   {
+      fprintf( stderr, "topicbench: cannot create a topic file\n" );
+      return 1;
+   }
+
+   gettimeofday( &start, NULL );
+   result = XscHelpLoadTopics( display, path );
+   gettimeofday( &end, NULL );
+
+   unlink( path );
+
+   if (result)
+   {
+      fprintf( stderr, "topicbench: %s\n", strerror( result ) );
+      return 1;
+   }
+
+   printf( "%d topics %12.1f msec\n", topics, elapsed( &start, &end ) / 1000 );
+
+   XCloseDisplay( display );
+   return 0;
+}
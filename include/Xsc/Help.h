@@ -51,6 +51,41 @@ enum
    XmXSC_SHOW_NAME_ALL
 };
 
+/*------------------------------------------------------------------------
+-- Help records are allocated from per-display pools.  These values
+-- identify a pool when asking for its statistics.
+------------------------------------------------------------------------*/
+enum
+{
+   XmXSC_POOL_OBJECT,
+   XmXSC_POOL_CUE,
+   XmXSC_POOL_HINT,
+   XmXSC_POOL_TIP,
+   XmXSC_POOL_TEXT,
+   XmXSC_POOL_TEXT_BODY,
+   XmXSC_POOL_COUNT
+};
+
+/*------------------------------------------------------------------------
+-- Each display counts some of the events it handles.  These values
+-- identify a counter when asking for its value.
+------------------------------------------------------------------------*/
+enum
+{
+   XmXSC_COUNTER_MOTION_EVENTS,        /* Motion events over composites */
+   XmXSC_COUNTER_GADGET_TRANSITIONS,   /* Pointer moved on/off a gadget */
+   XmXSC_COUNTER_TIP_POPUPS,           /* Tips popped up */
+   XmXSC_COUNTER_POINTER_QUERIES,      /* XQueryPointer round trips */
+   XmXSC_COUNTER_FRAME_QUERIES,        /* Round trips for WM frame geometry */
+   XmXSC_COUNTER_CUE_MOVES_REQUESTED,  /* Shell moves asking for a new cue */
+   XmXSC_COUNTER_CUE_MOVES_APPLIED,    /* ...and how many were carried out */
+   XmXSC_COUNTER_COLOR_DERIVATIONS,    /* XmGetColors calls for help colors */
+   XmXSC_COUNTER_REDRAWS_REQUESTED,    /* Help windows asked to be redrawn */
+   XmXSC_COUNTER_REDRAWS_APPLIED,      /* ...and how many were cleared */
+   XmXSC_COUNTER_DB_RELOADS,           /* Activations that reloaded help */
+   XmXSC_COUNTER_COUNT
+};
+
 /*------------------------------------------------------------------------
 -- The following are psuedo enumerated values used to specify specific
 -- callback reasons used by this toolkit.  They should be enumerated 
@@ -77,6 +112,16 @@ typedef struct
 XscHelpContextCallbackStruct;
 
 
+typedef struct
+{
+   Cardinal slabsInUse;
+   Cardinal bytesReserved;
+   Cardinal recordsInUse;
+   Cardinal highWaterMark;
+}
+XscHelpPoolStatistics;
+
+
 /*==============================================================================
                                External Variables
 ==============================================================================*/
@@ -102,13 +147,23 @@ void XscHelpContextPickAndActivate( Widget, Cursor, Boolean );
 
 void XscHelpDbReload( Widget );
 
+unsigned long XscHelpGetCounter   ( Widget, int );
+void          XscHelpResetCounters( Widget );
+
+Boolean XscHelpGetPoolStatistics( Widget, int, XscHelpPoolStatistics* );
+
+void XscHelpSetPixmapCacheSize( Widget, unsigned long );
+
 Boolean XscHelpHintExists ( Widget );
 void    XscHelpHintInstall( Widget );
 void    XscHelpHintUpdate ( Widget );
 
 void XscHelpInstall( Widget );
 
-int XscHelpLoadTopics( Display*, const char* );
+void XscHelpNotifyDbChanged( Widget );
+
+int XscHelpLoadTopicCatalog( Display*, const char* );
+int XscHelpLoadTopics      ( Display*, const char* );
 
 void XscHelpSetCueTopic        ( Widget, String );
 void XscHelpSetCueTopicDetails ( Widget, String, XmFontList, String, 
@@ -125,6 +180,8 @@ void    XscHelpTipUpdate( Widget );
 
 void XscHelpUpdate( Widget );
 
+int XscHelpWatchTopics( Widget );
+
 
 
 Boolean XscHelpAreCuesDisplayable ( Widget );
@@ -150,6 +207,15 @@ void XscHelpSetTipsEnabledGlobally ( Boolean );
 Boolean XscHelpIsDynamicTipGroupIdDefaultActive();
 void XscHelpSetDynamicTipGroupDefault( Boolean );
 
+Boolean XscHelpIsLazyLoadActive();
+void XscHelpSetLazyLoad( Boolean );
+
+Boolean XscHelpIsSparseRegistryActive();
+void XscHelpSetSparseRegistry( Boolean );
+
+Boolean XscHelpIsCentralDispatchActive();
+void XscHelpSetCentralDispatch( Boolean );
+
 
 #ifdef __cplusplus
 }  /* Close scope of 'extern "C"' declaration which encloses file. */
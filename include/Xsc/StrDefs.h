@@ -128,6 +128,10 @@ extern "C" {
 #define XmNxscFont "xscFont"
 #endif
 
+#ifndef XmNxscGadgetMotionHint
+#define XmNxscGadgetMotionHint "xscGadgetMotionHint"
+#endif
+
 #ifndef XmNxscGadgetProcessing
 #define XmNxscGadgetProcessing "xscGadgetProcessing"
 #endif
@@ -200,6 +204,10 @@ extern "C" {
 #define XmNxscHintTopic "xscHintTopic"
 #endif
 
+#ifndef XmNxscLazyLoad
+#define XmNxscLazyLoad "xscLazyLoad"
+#endif
+
 
 
 #ifndef XmNxscTipAlignment
@@ -294,6 +302,10 @@ extern "C" {
 #define XmNxscTipPosition "xscTipPosition"
 #endif
 
+#ifndef XmNxscTipRestoreInterval
+#define XmNxscTipRestoreInterval "xscTipRestoreInterval"
+#endif
+
 #ifndef XmNxscTipSelectNameInterval
 #define XmNxscTipSelectNameInterval "xscTipSelectNameInterval"
 #endif
@@ -444,6 +456,10 @@ extern "C" {
 #define XmCXscFont "XscFont"
 #endif
 
+#ifndef XmCXscGadgetMotionHint
+#define XmCXscGadgetMotionHint "XscGadgetMotionHint"
+#endif
+
 #ifndef XmCXscGadgetProcessing
 #define XmCXscGadgetProcessing "XscGadgetProcessing"
 #endif
@@ -516,6 +532,10 @@ extern "C" {
 #define XmCXscHintTopic "XscHintTopic"
 #endif
 
+#ifndef XmCXscLazyLoad
+#define XmCXscLazyLoad "XscLazyLoad"
+#endif
+
 
 #ifndef XmCXscTipAlignment
 #define XmCXscTipAlignment "XscTipAlignment"
@@ -609,6 +629,10 @@ extern "C" {
 #define XmCXscTipPosition "XscTipPosition"
 #endif
 
+#ifndef XmCXscTipRestoreInterval
+#define XmCXscTipRestoreInterval "XscTipRestoreInterval"
+#endif
+
 #ifndef XmCXscTipSelectNameInterval
 #define XmCXscTipSelectNameInterval "XscTipSelectNameInterval"
 #endif
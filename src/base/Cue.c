@@ -19,6 +19,7 @@
 #include "CueP.h"
 #include "DisplayP.h"
 #include "ObjectP.h"
+#include "ResourceP.h"
 #include "ScreenP.h"
 #include "ShellP.h"
 #include "TextP.h"
@@ -58,19 +59,39 @@ typedef struct _XscCueRec
    unsigned char shadowType;
    unsigned char position;          /* Cue layout policy */
    Boolean       autoDbReload;
+   unsigned long dbGeneration;      /* When the resources were loaded */
    Boolean       enabled;
    Boolean       motifColorModel;
    int           xOffset;
    int           yOffset;
+   XscScreenColorsRec _colors;      /* Derived from the background */
 }
 XscCueRec;
 
 
+/*------------------------------------------------------------------------------
+-- This function makes sure the derived colors match the current color
+-- attributes.  The screen keeps what XmGetColors returned, so this is only
+-- a lookup after the first time.
+------------------------------------------------------------------------------*/
+static void _resolveColors( XscCue self )
+{
+   XscScreen screen = _XscObjectGetScreen( self->object );
+   Widget    frame  = _XscScreenGetCueFrame( screen );
+
+   _XscScreenGetColors(
+      screen,
+      frame->core.colormap,
+      self->motifColorModel ? self->background : self->colorBase,
+      &self->_colors );
+}
+
+
 XscCue _XscCueCreate( XscObject o )
 {
-   XscCue self = XtNew( XscCueRec );
+   XscCue self = (XscCue) _XscDisplayAllocRecord( 
+      _XscObjectGetDisplay( o ), XmXSC_POOL_CUE, sizeof( XscCueRec ) );
    
-   memset( (void*) self, '\0', sizeof( *self ) );
    self->text   = NULL;
    self->object = o;
 
@@ -80,7 +101,8 @@ XscCue _XscCueCreate( XscObject o )
 void _XscCueDestroy( XscCue self )
 {
    if (self->text) _XscTextDestroy( self->text );
-   XtFree( (char*) self );
+   _XscDisplayFreeRecord( 
+      _XscObjectGetDisplay( self->object ), XmXSC_POOL_CUE, (XtPointer) self );
 }
 
 
@@ -186,11 +208,11 @@ void _XscCueLoadResources( XscCue self, XscText text )
 
    Widget w = _XscObjectGetWidget( self->object );
    
-   XtGetApplicationResources( 
-      w,
-      self, 
-      resource,   (Cardinal) XtNumber( resource ),
-      NULL,       (Cardinal) 0 );
+   _XscResourceGetValues( 
+      w, (XtPointer) self, resource, (Cardinal) XtNumber( resource ) );
+   
+   self->dbGeneration = 
+      _XscDisplayGetDbGeneration( _XscObjectGetDisplay( self->object ) );
    
    if (text)
    {
@@ -207,10 +229,12 @@ void _XscCueLoadResources( XscCue self, XscText text )
    {
       if (self->text == NULL)
       {
-         self->text = _XscTextCreate();
+         self->text = 
+            _XscTextCreate( _XscObjectGetDisplay( self->object ) );
       }
       _XscTextLoadCueResources( self->text, w, NULL );
    }
+   _resolveColors( self );
    
    if (self->yOffset == XscHelpDefaultCueYOffsetDynamic)
    {
@@ -232,11 +256,9 @@ void _XscCueActivate( XscCue self )
 {
    XscDisplay hpt_display;
    XscShell   htk_shell;
-   Widget     w;
    
-   w = _XscObjectGetWidget( self->object );
-   hpt_display = _XscDisplayDeriveFromWidget( w );
-   htk_shell   = _XscShellDeriveFromWidget( w );
+   hpt_display = _XscObjectGetDisplay( self->object );
+   htk_shell   = _XscObjectGetShell( self->object );
    
    if (_XscShellIsCueDisplayable( htk_shell ))
    {
@@ -247,10 +269,12 @@ void _XscCueActivate( XscCue self )
 
       /*--------------------------------------------------------------
       -- If the cue needs to be dynamically updated, then reload its
-      -- attributes from the resource database
+      -- attributes once the resource database has changed
       --------------------------------------------------------------*/
-      if (self->autoDbReload)
+      if (self->autoDbReload && (self->dbGeneration != 
+          _XscDisplayGetDbGeneration( hpt_display )))
       {
+         _XscDisplayIncrementCounter( hpt_display, XmXSC_COUNTER_DB_RELOADS );
 	 _XscCueLoadResources( self, NULL );
       }
 
@@ -275,16 +299,14 @@ void _XscCueUpdate( XscCue self )
    XscDisplay hpt_display;
    XscScreen  hpt_screen;
    int        text_height, text_width, popup_height, popup_width;
-   Pixel      foreground_color, select_color;
-   Pixel      top_shadow_color, bottom_shadow_color;
    Widget     object_widget;
    
    object_widget = _XscObjectGetWidget( self->object );
-   hpt_screen = _XscScreenDeriveFromWidget( object_widget );
+   hpt_screen = _XscObjectGetScreen( self->object );
    assert( hpt_screen );
    screen = XtScreenOfObject( object_widget );
 
-   hpt_display = _XscDisplayDeriveFromWidget( object_widget );
+   hpt_display = _XscObjectGetDisplay( self->object );
 
    /*---------------------------------------------
    -- Determine the size of the cue drawing area
@@ -309,64 +331,18 @@ void _XscCueUpdate( XscCue self )
 
    if (self->position == XmXSC_CUE_POSITION_SHELL)
    {
-      /*------------------------
-      -- Find the shell widget
-      ------------------------*/
-      Widget       shell   = object_widget;
-      Display*     display = XtDisplayOfObject( shell );
-      Window       frame, parent, root;
-      Window*      children;
+      /*-----------------------------------------------------------
+      -- The shell record tracks where the window manager's frame is
+      -----------------------------------------------------------*/
+      XscShell     htk_shell = _XscObjectGetShell( self->object );
       int          frame_x, frame_y;
-      int          parent_x, parent_y;
       unsigned int frame_width , frame_height , frame_border;
-      unsigned int parent_width, parent_height, parent_border, parent_depth;
-      unsigned int num_children;
-      Screen*      screen;
-      
-      while (!XtIsWMShell( shell )) shell = XtParent( shell );
-      
-      assert( XtIsRealized( shell ) );
-      
-      screen = XtScreen( shell );
-      frame  = XtWindow( shell );
-      frame_x      = shell->core.x;
-      frame_y      = shell->core.y;
-      frame_width  = shell->core.width;
-      frame_height = shell->core.height;
-      frame_border = shell->core.border_width;
       
-      for(;;)
-      {
-         XQueryTree( display, frame, &root, &parent, &children, &num_children);
-         if (children) XFree( (void*) children );
-         
-         if (parent == root) break;
-         
-         XGetGeometry( 
-            display, 
-            parent, 
-            &root, 
-            &parent_x, 
-            &parent_y,
-            &parent_width,
-            &parent_height,
-            &parent_border,
-            &parent_depth );
-
-         if (parent_width == WidthOfScreen( screen ))
-         {
-            if (parent_height == HeightOfScreen( screen ))
-            {
-               break;
-            }
-         }
-         frame        = parent;
-         frame_x      = parent_x;
-         frame_y      = parent_y;
-         frame_width  = parent_width;
-         frame_height = parent_height;
-         frame_border = parent_border;
-      }
+      assert( htk_shell );
+
+      _XscShellGetFrameGeometry( 
+         htk_shell, 
+         &frame_x, &frame_y, &frame_width, &frame_height, &frame_border );
 
       popup_y = frame_y - frame_border - popup_height + self->yOffset;
 
@@ -496,69 +472,26 @@ void _XscCueUpdate( XscCue self )
    }
 
    {
-      Widget cue_shell, cue_frame, cue_label;
-
-      cue_shell = _XscScreenGetCueShell( hpt_screen );
-      cue_frame = _XscScreenGetCueFrame( hpt_screen );
-      cue_label = _XscScreenGetCueLabel( hpt_screen );
-
-      /*---------------------------------------
-      -- Specify the window border attributes
-      ---------------------------------------*/
-      XtVaSetValues(
-         cue_shell, 
-         XtNx,		(Position) popup_x,
-         XtNy,		(Position) popup_y,
-         XtNborderWidth,self->borderWidth,
-         XtNborderColor,self->borderColor,
-         NULL );
+      XscScreenLayoutRec layout;
 
       /*-----------------------------------------------------
       -- Determine the colors to use for the shadow borders
       -----------------------------------------------------*/
-      if (self->motifColorModel)
-      {
-         XmGetColors(
-            screen,
-            cue_frame->core.colormap,
-            self->background,
-            &foreground_color,
-            &top_shadow_color,
-            &bottom_shadow_color,
-            &select_color );
-      }
-      else
-      {
-         XmGetColors(
-            screen,
-            cue_frame->core.colormap,
-            self->colorBase,
-            &foreground_color,
-            &top_shadow_color,
-            &bottom_shadow_color,
-            &select_color );
-      }
-
-      /*---------------------------------------
-      -- Specify the shadow border attributes
-      ---------------------------------------*/
-      XtVaSetValues(
-         cue_frame,
-         XmNshadowThickness,    self->shadowThickness,
-         XmNshadowType,         self->shadowType,
-         XmNtopShadowColor,     top_shadow_color,
-         XmNbottomShadowColor,  bottom_shadow_color,
-         NULL );
-
-      /*--------------------------------------------------------
-      -- Assign the height and width to the cue display widget
-      --------------------------------------------------------*/
-      XtVaSetValues(
-         cue_label,
-         XtNbackground, self->background,
-         XtNwidth,      (Dimension) text_width,
-         XtNheight,     (Dimension) text_height,
-         NULL );
+      _resolveColors( self );
+
+      layout.x               = (Position) popup_x;
+      layout.y               = (Position) popup_y;
+      layout.borderWidth     = self->borderWidth;
+      layout.borderColor     = self->borderColor;
+      layout.shadowThickness = self->shadowThickness;
+      layout.shadowType      = self->shadowType;
+      layout.topShadow       = self->_colors.topShadow;
+      layout.bottomShadow    = self->_colors.bottomShadow;
+      layout.width           = (Dimension) text_width;
+      layout.height          = (Dimension) text_height;
+      layout.background      = self->background;
+
+      _XscScreenLayoutCue( hpt_screen, &layout );
    }         
 }
 
@@ -567,15 +500,14 @@ void _XscCueUpdate( XscCue self )
 ------------------------------------------------------------------------------*/
 void _XscCuePopdown( XscCue self )
 {
-   Widget object_widget = _XscObjectGetWidget( self->object );
-   XscDisplay hpt_display = _XscDisplayDeriveFromWidget( object_widget );
+   XscDisplay hpt_display = _XscObjectGetDisplay( self->object );
    
    /*-----------------------------------------------------------------------
    -- Verify that this object is the object recorded in the display record
    -----------------------------------------------------------------------*/
    if (self == _XscDisplayGetActiveCue( hpt_display ))
    {
-      XscScreen hpt_screen = _XscScreenDeriveFromWidget( object_widget );
+      XscScreen hpt_screen = _XscObjectGetScreen( self->object );
       
       /*------------------------------------------------------
       -- Stop all the (potential) timers and popdown the cue
@@ -592,7 +524,7 @@ void _XscCuePopdown( XscCue self )
 void _XscCuePopup( XscCue self )
 {
    Widget object_widget = _XscObjectGetWidget( self->object );
-   XscScreen hpt_screen = _XscScreenDeriveFromWidget( object_widget );
+   XscScreen hpt_screen = _XscObjectGetScreen( self->object );
 
    Screen*       screen;
    
@@ -615,8 +547,10 @@ void _XscCueRender( XscCue self, Widget cue_widget, GC gc )
 {
    if (XscCueHasValidTopic( self ))
    {
-      Pixel        foreground_color, select_color;
-      Pixel        top_shadow_color, bottom_shadow_color;
+      Pixel        foreground_color;
+      XscScreenPixmapKeyRec key;
+      Pixmap       pixmap;
+      Boolean      created;
       Display*     display    = XtDisplay( cue_widget );
 
       /*---------------------
@@ -629,35 +563,65 @@ void _XscCueRender( XscCue self, Widget cue_widget, GC gc )
       ---------------------------------------------*/
       if (self->motifColorModel)
       {
-         XmGetColors(
-            XtScreen( cue_widget ),
-            cue_widget->core.parent->core.colormap,
-            self->background,
-            &foreground_color,
-            &top_shadow_color,
-            &bottom_shadow_color,
-            &select_color );
+         _resolveColors( self );
+         foreground_color = self->_colors.foreground;
       }
       else
       {
          foreground_color = self->foreground;
       }
 
-      /*------------------
-      -- Render the text
-      ------------------*/
-      _XscTextStringDraw( 
-         self->text,
-         display,
-         XtWindow( cue_widget ),
-         gc,
-         self->marginWidth  + self->marginLeft, 
-         self->marginHeight + self->marginTop,
-         0,
-         NULL,
-	 self->background,
-	 foreground_color,
-	 False );
+      /*-------------------------------------------------------------
+      -- The text is rendered into a pixmap kept by the screen, so
+      -- another expose, or showing the same text again, is a copy
+      -------------------------------------------------------------*/
+      key.serial     = _XscTextGetSerial( self->text );
+      key.width      = cue_widget->core.width;
+      key.height     = cue_widget->core.height;
+      key.x          = self->marginWidth  + self->marginLeft;
+      key.y          = self->marginHeight + self->marginTop;
+      key.background = self->background;
+      key.foreground = foreground_color;
+      key.selected   = False;
+
+      pixmap = _XscScreenGetPixmap( 
+         _XscObjectGetScreen( self->object ), cue_widget, &key, &created );
+
+      if (created)
+      {
+         XSetForeground( display, gc, self->background );
+         XFillRectangle( display, pixmap, gc, 0, 0, key.width, key.height );
+      }
+
+      /*----------------------------------------------------
+      -- Render the text (straight to the window if there
+      -- is no room for it in the cache)
+      ----------------------------------------------------*/
+      if (created || (pixmap == None))
+      {
+         _XscTextStringDraw( 
+            self->text,
+            display,
+            pixmap ? pixmap : XtWindow( cue_widget ),
+            gc,
+            key.x, 
+            key.y,
+            0,
+            NULL,
+            self->background,
+            foreground_color,
+            key.selected );
+      }
+
+      if (pixmap)
+      {
+         XCopyArea( 
+            display, 
+            pixmap, 
+            XtWindow( cue_widget ), 
+            gc, 
+            0, 0, key.width, key.height, 0, 0 );
+      }
    }
 }
 
@@ -751,7 +715,7 @@ void XscCueSetAlignment( XscCue self, unsigned char a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( _XscCueGetObject( self ) );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -761,7 +725,7 @@ void XscCueSetFontList( XscCue self, XmFontList a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( _XscCueGetObject( self ) );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -771,7 +735,7 @@ void XscCueSetFontListTag( XscCue self, String a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( _XscCueGetObject( self ) );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -781,7 +745,7 @@ void XscCueSetStringConverter( XscCue self, unsigned char a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( _XscCueGetObject( self ) );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -791,7 +755,7 @@ void XscCueSetStringDirection( XscCue self, unsigned char a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( _XscCueGetObject( self ) );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -800,7 +764,7 @@ void XscCueSetTopic( XscCue self, String a )
    Widget w = _XscObjectGetWidget( _XscCueGetObject( self ) );
    
    _XscTextSetTopic( self->text, XtNewString( a ) );
-   _XscTextCreateCompoundString( self->text, w );
+   _XscTextMarkDirty( self->text, w );
 }
 
 
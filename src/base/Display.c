@@ -16,10 +16,12 @@
 #include <Xm/Display.h>
 
 #include <Xsc/Help.h>
+#include <Xsc/StrDefs.h>
 
 #include "CueP.h"
 #include "DisplayP.h"
 #include "ObjectP.h"
+#include "PoolP.h"
 #include "ScreenP.h"
 #include "TipP.h"
 
@@ -37,13 +39,34 @@ typedef struct _XscDisplayRec
    XscObject     hintActive;       /* What hint/tip object is active? */
    XscObject     tipActive;
    XscObject     tipSelectedName;
-   XtIntervalId  tipTimerCancelRestore;
-   XtIntervalId  tipTimerPopup;
-   XtIntervalId  tipTimerPopdown;
-   XtIntervalId  tipTimerSelectName;
+   XscTimer      timers;           /* Schedules all the timers below */
+   XscTimerEntryRec tipTimerPopup;
+   XscTimerEntryRec tipTimerPopdown;
+   XscTimerEntryRec tipTimerSelectName;
+   XtWorkProcId  cueMoveWorkProc;  /* Pending move of the active cue */
+   XtWorkProcId  redrawWorkProc;   /* Pending redraws of help windows */
+   Widget*       redraws;          /* Widgets waiting to be redrawn */
+   Cardinal      redrawCount;
+   Cardinal      redrawSize;
    int           tipActiveGroupId;
    int           tipRestoreGroupId;
    Boolean       tipRestorePrimed;
+   Time          tipRestoreTime;   /* When the pointer left the shell */
+   int           tipRestoreInterval;   /* Milliseconds */
+   Cardinal      referenceCount;   /* How many records point to this one? */
+   Boolean       closed;           /* Has the display been closed? */
+   XscPool       pools[ XmXSC_POOL_COUNT ];  /* Help record allocators */
+   XscTextTable  textTable;        /* Text bodies widgets can share */
+   XscTopicTable topics;           /* Loaded with XscHelpLoadTopics() */
+   Boolean       dispatcherInstalled;
+   XtEventDispatchProc dispatchProc;            /* Installed dispatcher */
+   XtEventDispatchProc dispatcher[ LASTEvent ]; /* Replaced dispatchers */
+   struct _XscDisplayRec* nextDispatching;      /* See _dispatching */
+   unsigned long counters[ XmXSC_COUNTER_COUNT ];
+   unsigned long dbGeneration;     /* Counts changes to the resources */
+   Window        pointerRoot;      /* Last pointer position seen in an */
+   int           pointerRootX;     /* event, or None if not known yet  */
+   int           pointerRootY;
 }
 XscDisplayRec;
 
@@ -51,11 +74,16 @@ XscDisplayRec;
                             Private prototypes
 ==============================================================================*/
 static void _destroyDisplayCB( Widget, XtPointer, XtPointer );
+static void _freeDisplay     ( XscDisplay );
 
-static void _cancelRestoreTO( XtPointer, XtIntervalId* );
-static void _popdownTipTO   ( XtPointer, XtIntervalId* );
-static void _popupTipTO     ( XtPointer, XtIntervalId* );
-static void _selectNameTipTO( XtPointer, XtIntervalId* );
+static Boolean _moveCueWP( XtPointer );
+static Boolean _redrawWP ( XtPointer );
+
+static void _forgetRedrawCB( Widget, XtPointer, XtPointer );
+
+static void _popdownTipTO   ( XtPointer );
+static void _popupTipTO     ( XtPointer );
+static void _selectNameTipTO( XtPointer );
 
 
 /*==============================================================================
@@ -67,6 +95,13 @@ static void _selectNameTipTO( XtPointer, XtIntervalId* );
 -----------------------------------------------------------------------*/
 static XContext _displayContextId;
 
+/*-----------------------------------------------------------------------
+-- The displays with an installed dispatcher.  The dispatcher passes
+-- every event on, including those of windows the library does not 
+-- know, so their replaced dispatchers are found without a lookup.
+-----------------------------------------------------------------------*/
+static XscDisplay _dispatching = NULL;
+
 
 
 /*==============================================================================
@@ -98,6 +133,7 @@ void _XscDisplayInitialize( XContext context )
 XscDisplay _XscDisplayCreate( Widget obj )
 {
    XscDisplay self;
+   int        i;
    
    /*-------------------------------------
    -- Make a Help ToolKit display record
@@ -113,13 +149,67 @@ XscDisplay _XscDisplayCreate( Widget obj )
    self->tipActive             = NULL;
    self->tipSelectedName       = NULL;
    self->cueActive             = NULL;
-   self->tipTimerCancelRestore = (XtIntervalId) NULL;
-   self->tipTimerPopup         = (XtIntervalId) NULL;
-   self->tipTimerPopdown       = (XtIntervalId) NULL;
-   self->tipTimerSelectName    = (XtIntervalId) NULL;
+   self->timers                = _XscTimerCreate( self->appContext );
+   self->cueMoveWorkProc       = (XtWorkProcId) NULL;
+   self->redrawWorkProc        = (XtWorkProcId) NULL;
+   self->redraws               = NULL;
+   self->redrawCount           = 0;
+   self->redrawSize            = 0;
    self->tipActiveGroupId      = XmXSC_TIP_GROUP_NULL;
    self->tipRestoreGroupId     = self->tipActiveGroupId;
    self->tipRestorePrimed      = False;
+   self->tipRestoreTime        = CurrentTime;
+   self->tipRestoreInterval    = XscHelpDefaultTipRestoreInterval;
+   self->referenceCount        = 0;
+   self->closed                = False;
+   self->dispatcherInstalled   = False;
+   self->dispatchProc          = NULL;
+   self->nextDispatching       = NULL;
+   self->pointerRoot           = None;
+   self->pointerRootX          = 0;
+   self->pointerRootY          = 0;
+   self->dbGeneration          = 0;
+   self->textTable             = _XscTextTableCreate();
+   self->topics                = _XscTopicTableDeriveFromDisplay( 
+                                    self->xDisplay, True );
+
+   _XscTimerInitEntry( &self->tipTimerPopup      );
+   _XscTimerInitEntry( &self->tipTimerPopdown    );
+   _XscTimerInitEntry( &self->tipTimerSelectName );
+
+   /*-------------------------------------------------------------
+   -- The tip restore window applies to the whole display, so it
+   -- is an application resource
+   -------------------------------------------------------------*/
+   {
+      static XtResource resource[] =
+      {
+         {
+            XmNxscTipRestoreInterval, XmCXscTipRestoreInterval,
+            XmRInt, sizeof( int ), 
+            XtOffsetOf( XscDisplayRec, tipRestoreInterval ),
+            XtRImmediate, (XtPointer) XscHelpDefaultTipRestoreInterval
+         }
+      };
+
+      XtGetApplicationResources( 
+         obj, (XtPointer) self, resource, XtNumber( resource ), NULL, 0 );
+   }
+
+   for (i = 0; i < LASTEvent; i++)
+   {
+      self->dispatcher[ i ] = NULL;
+   }
+
+   for (i = 0; i < XmXSC_POOL_COUNT; i++)
+   {
+      self->pools[ i ] = NULL;
+   }
+
+   for (i = 0; i < XmXSC_COUNTER_COUNT; i++)
+   {
+      self->counters[ i ] = 0;
+   }
 
    /*-----------------------------------------------------
    -- Watch for when the display is no longer being used
@@ -147,13 +237,19 @@ XscDisplay _XscDisplayCreate( Widget obj )
 -- from the context manager
 ------------------------------------------------------------------------------*/
 XscDisplay _XscDisplayDeriveFromWidget( Widget obj )
+{
+   return _XscDisplayDeriveFromDisplay( XtDisplayOfObject( obj ) );
+}
+
+/*------------------------------------------------------------------------------
+-- This function retrieves the display structure of an X display
+------------------------------------------------------------------------------*/
+XscDisplay _XscDisplayDeriveFromDisplay( Display* x_display )
 {
    XscDisplay self;
-   Display*   x_display;
    XPointer   data;
    int        not_found;
    
-   x_display = XtDisplayOfObject( obj );
    not_found = XFindContext( x_display,(XID)x_display,_displayContextId,&data );
 
    if (not_found)
@@ -169,6 +265,251 @@ XscDisplay _XscDisplayDeriveFromWidget( Widget obj )
 
 
 
+/*-------------------------------------------------------------------------
+-- Object, screen, and shell records keep a pointer to their display
+-- record.  These functions make sure that the display record outlives
+-- all of them, even if the display is closed first.
+-------------------------------------------------------------------------*/
+void _XscDisplayAddReference( XscDisplay self )
+{
+   self->referenceCount += 1;
+}
+
+void _XscDisplayRemoveReference( XscDisplay self )
+{
+   assert( self->referenceCount > 0 );
+
+   self->referenceCount -= 1;
+   if (self->closed && (self->referenceCount == 0))
+   {
+      _freeDisplay( self );
+   }
+}
+
+
+/*-------------------------------------------------------------------------
+-- Object, cue, hint, tip, and text records are carved out of pools owned
+-- by the display record.  The pools are created on first use.
+-------------------------------------------------------------------------*/
+XtPointer _XscDisplayAllocRecord( XscDisplay self, int pool, Cardinal size )
+{
+   assert( (pool >= 0) && (pool < XmXSC_POOL_COUNT) );
+
+   if (self->pools[ pool ] == NULL)
+   {
+      self->pools[ pool ] = 
+         _XscPoolCreate( size, XscHelpDefaultPoolRecordsPerSlab );
+   }
+   return _XscPoolAlloc( self->pools[ pool ] );
+}
+
+void _XscDisplayFreeRecord( XscDisplay self, int pool, XtPointer record )
+{
+   assert( (pool >= 0) && (pool < XmXSC_POOL_COUNT) );
+   assert( self->pools[ pool ] );
+
+   _XscPoolFree( self->pools[ pool ], record );
+}
+
+
+/*-------------------------------------------------------------------------
+-- The resource database generation advances whenever the help resources
+-- may have changed.  Help with autoDbReload set is only reloaded when it
+-- was loaded in an earlier generation.
+-------------------------------------------------------------------------*/
+unsigned long _XscDisplayGetDbGeneration( XscDisplay self )
+{
+   return self->dbGeneration;
+}
+
+void _XscDisplayNotifyDbChanged( XscDisplay self )
+{
+   self->dbGeneration += 1;
+}
+
+
+/*-------------------------------------------------------------------------
+-- The event counters are cheap enough to always be kept
+-------------------------------------------------------------------------*/
+void _XscDisplayIncrementCounter( XscDisplay self, int counter )
+{
+   assert( (counter >= 0) && (counter < XmXSC_COUNTER_COUNT) );
+
+   self->counters[ counter ] += 1;
+}
+
+
+/*-------------------------------------------------------------------------
+-- The crossing and motion events that lead to a tip carry the pointer's
+-- root coordinates.  Remembering them saves a round trip to the server
+-- when the tip pops up.
+-------------------------------------------------------------------------*/
+void _XscDisplayTrackPointer( XscDisplay self, Window root, int x, int y )
+{
+   self->pointerRoot  = root;
+   self->pointerRootX = x;
+   self->pointerRootY = y;
+}
+
+Boolean _XscDisplayGetPointer( XscDisplay self, Window root, int* x, int* y )
+{
+   if ((self->pointerRoot == None) || (self->pointerRoot != root))
+   {
+      return False;
+   }
+   *x = self->pointerRootX;
+   *y = self->pointerRootY;
+
+   return True;
+}
+
+
+/*-------------------------------------------------------------------------
+-- This function routes the crossing and focus events of the display
+-- through the given dispatcher.  The dispatchers it replaces are kept so
+-- the new one can pass each event on first.  It returns False if the
+-- Intrinsics have no dispatcher hook (pre-X11R6).
+-------------------------------------------------------------------------*/
+Boolean _XscDisplayInstallEventDispatcher( 
+   XscDisplay          self, 
+   XtEventDispatchProc proc )
+{
+#if XtVersion >= 11006
+   static int types[] = { EnterNotify, LeaveNotify, FocusIn, FocusOut };
+   int        i;
+
+   if (!self->dispatcherInstalled)
+   {
+      for (i = 0; i < XtNumber( types ); i++)
+      {
+         self->dispatcher[ types[i] ] = 
+            XtSetEventDispatcher( self->xDisplay, types[i], proc );
+      }
+      self->dispatchProc        = proc;
+      self->dispatcherInstalled = True;
+      self->nextDispatching     = _dispatching;
+      _dispatching              = self;
+   }
+   return True;
+#else
+   return False;
+#endif
+}
+
+
+/*-------------------------------------------------------------------------
+-- This function puts back the dispatchers _XscDisplayInstallEventDispatcher
+-- replaced.  A dispatcher installed after ours is left in place.
+-------------------------------------------------------------------------*/
+void _XscDisplayUninstallEventDispatcher( XscDisplay self )
+{
+#if XtVersion >= 11006
+   static int types[] = { EnterNotify, LeaveNotify, FocusIn, FocusOut };
+   XscDisplay* link;
+   int         i;
+
+   if (!self->dispatcherInstalled)
+   {
+      return;
+   }
+
+   for (i = 0; i < XtNumber( types ); i++)
+   {
+      XtEventDispatchProc current = XtSetEventDispatcher( 
+         self->xDisplay, types[i], self->dispatcher[ types[i] ] );
+
+      if (current != self->dispatchProc)
+      {
+         XtSetEventDispatcher( self->xDisplay, types[i], current );
+      }
+   }
+
+   for (link = &_dispatching; *link != self; link = &(*link)->nextDispatching)
+   {
+   }
+   *link = self->nextDispatching;
+
+   self->dispatcherInstalled = False;
+#endif
+}
+
+
+/*-------------------------------------------------------------------------
+-- This function passes an event to the dispatcher that was replaced
+-------------------------------------------------------------------------*/
+Boolean _XscDisplayDispatchEvent( XEvent* event )
+{
+   XscDisplay display = _dispatching;
+
+   while (display && (display->xDisplay != event->xany.display))
+   {
+      display = display->nextDispatching;
+   }
+   assert( display && display->dispatcher[ event->type ] );
+   
+   return (*display->dispatcher[ event->type ])( event );
+}
+
+
+/*-------------------------------------------------------------------------
+-- Moving a window produces a stream of ConfigureNotify events.  Instead
+-- of moving the cue for each of them, the move is done once, by a work
+-- procedure, after the pending events have been processed.
+-------------------------------------------------------------------------*/
+void _XscDisplayRequestCueMove( XscDisplay self )
+{
+   _XscDisplayIncrementCounter( self, XmXSC_COUNTER_CUE_MOVES_REQUESTED );
+
+   if (!self->cueMoveWorkProc)
+   {
+      self->cueMoveWorkProc = XtAppAddWorkProc(
+         self->appContext, 
+         _moveCueWP, 
+         (XtPointer) self );
+   }
+}
+
+
+/*-------------------------------------------------------------------------
+-- Help windows are redrawn by clearing them, which makes the server send
+-- an expose.  The widgets are collected here and cleared together, with 
+-- one flush, by a work procedure once the pending events are processed.
+-- Asking again for a widget that is already waiting does nothing.
+-------------------------------------------------------------------------*/
+void _XscDisplayRequestRedraw( XscDisplay self, Widget w )
+{
+   Cardinal i;
+
+   _XscDisplayIncrementCounter( self, XmXSC_COUNTER_REDRAWS_REQUESTED );
+
+   for (i = 0; i < self->redrawCount; i++)
+   {
+      if (self->redraws[ i ] == w) return;
+   }
+
+   if (self->redrawCount == self->redrawSize)
+   {
+      self->redrawSize += 8;
+      self->redraws = (Widget*) XtRealloc( 
+         (char*) self->redraws, sizeof( Widget ) * self->redrawSize );
+   }
+   self->redraws[ self->redrawCount++ ] = w;
+
+   /*----------------------------------------------------
+   -- Forget the widget if it goes away in the meantime
+   ----------------------------------------------------*/
+   XtAddCallback( w, XtNdestroyCallback, _forgetRedrawCB, (XtPointer) self );
+
+   if (!self->redrawWorkProc)
+   {
+      self->redrawWorkProc = XtAppAddWorkProc(
+         self->appContext, 
+         _redrawWP, 
+         (XtPointer) self );
+   }
+}
+
+
 /*--------------------------------------------------------------------------
 -- This function indicates if the specified id matches the active group id
 --------------------------------------------------------------------------*/
@@ -183,11 +524,7 @@ Boolean _XscDisplayActiveTipGroupIdEquals( XscDisplay self, int id )
 -----------------------------------------------*/
 void _XscDisplayCancelTimerTipPopdown( XscDisplay self )
 {
-   if (self->tipTimerPopdown)
-   {
-      XtRemoveTimeOut( self->tipTimerPopdown );
-      self->tipTimerPopdown = (XtIntervalId) NULL;
-   }
+   _XscTimerCancel( self->timers, &self->tipTimerPopdown );
 }
 
 /*-----------------------------------------------
@@ -195,21 +532,13 @@ void _XscDisplayCancelTimerTipPopdown( XscDisplay self )
 -----------------------------------------------*/
 void _XscDisplayCancelTimerTipPopup( XscDisplay self )
 {
-   if (self->tipTimerPopup)
-   {
-      XtRemoveTimeOut( self->tipTimerPopup );
-      self->tipTimerPopup = (XtIntervalId) NULL;
-   }
+   _XscTimerCancel( self->timers, &self->tipTimerPopup );
 }
 
 
 void _XscDisplayCancelTimerSelectName( XscDisplay self )
 {
-   if (self->tipTimerSelectName)
-   {
-      XtRemoveTimeOut( self->tipTimerSelectName );
-      self->tipTimerSelectName = (XtIntervalId) NULL;
-   }
+   _XscTimerCancel( self->timers, &self->tipTimerSelectName );
 }
 
 
@@ -225,12 +554,6 @@ void _XscDisplayCheckForTipGroupIdMatch( XscDisplay self, int id )
       {
          self->tipActiveGroupId = id;
          self->tipRestorePrimed = False;
-
-         if (self->tipTimerCancelRestore)
-         {
-            XtRemoveTimeOut( self->tipTimerCancelRestore );
-            self->tipTimerCancelRestore = (XtIntervalId) NULL;
-         }
       }
    }
    else if (self->tipActiveGroupId != id)
@@ -247,6 +570,30 @@ XscCue _XscDisplayGetActiveCue( XscDisplay self )
    return self->cueActive;
 }
 
+/*------------------------------------------------------------
+-- This function retrieves the table of shared text bodies
+------------------------------------------------------------*/
+XscTextTable _XscDisplayGetTextTable( XscDisplay self )
+{
+   return self->textTable;
+}
+
+/*----------------------------------------------------------
+-- This function retrieves the scheduler of the display
+----------------------------------------------------------*/
+XscTimer _XscDisplayGetTimers( XscDisplay self )
+{
+   return self->timers;
+}
+
+/*----------------------------------------------------------
+-- This function retrieves the topics loaded for the display
+----------------------------------------------------------*/
+XscTopicTable _XscDisplayGetTopics( XscDisplay self )
+{
+   return self->topics;
+}
+
 /*-------------------------------------------------
 -- This function retrieves the active hint object
 -------------------------------------------------*/
@@ -270,17 +617,27 @@ XscObject _XscDisplayGetSelectedTip( XscDisplay self )
 
 /*-----------------------------------------------------------------------
 -- This function is called to notify the display that the Tip is lost
--- (due to being touched perhaps) and may need to be restored.
+-- (due to being touched perhaps) and may need to be restored.  The time
+-- is that of the event that took the pointer out of the shell.
 -----------------------------------------------------------------------*/
-void _XscDisplayPrimeTipRestore( XscDisplay self )
+void _XscDisplayPrimeTipRestore( XscDisplay self, Time time )
 {
    self->tipRestorePrimed = True;
+   self->tipRestoreTime   = time;
+}
 
-   self->tipTimerCancelRestore = XtAppAddTimeOut(
-      self->appContext,
-      100,
-      _cancelRestoreTO,
-      (XtPointer) self );
+/*-----------------------------------------------------------------------
+-- This function is called with the time of each crossing event.  If
+-- the pointer took too long to come back, the tip group is forgotten.
+-----------------------------------------------------------------------*/
+void _XscDisplayExpireTipRestore( XscDisplay self, Time time )
+{
+   if (self->tipRestorePrimed && 
+       (time - self->tipRestoreTime > (Time) self->tipRestoreInterval))
+   {
+      self->tipRestoreGroupId = self->tipActiveGroupId = XmXSC_TIP_GROUP_NULL;
+      self->tipRestorePrimed  = False;
+   }
 }
 
 /*------------------------------------
@@ -331,13 +688,9 @@ void _XscDisplaySetTipActiveGroupId( XscDisplay self, int id )
 
 void _XscDisplayStartTimerTipPopdown( XscDisplay self, XscObject object )
 {
-   if (self->tipTimerPopdown)
-   {
-      XtRemoveTimeOut( self->tipTimerPopdown );
-   }
-
-   self->tipTimerPopdown = XtAppAddTimeOut(
-      self->appContext,
+   _XscTimerStart(
+      self->timers,
+      &self->tipTimerPopdown,
       XscTipGetPopdownInterval( _XscObjectGetTip( object ) ),
       _popdownTipTO,
       (XtPointer) object );
@@ -356,13 +709,9 @@ void _XscDisplayStartTimerTipPopup( XscDisplay self, XscObject object )
    -- Start a new timer to see if the tip should be rendered
    -- for this object
    ---------------------------------------------------------*/
-   if (self->tipTimerPopup)
-   {
-      XtRemoveTimeOut( self->tipTimerPopup );
-   }
-
-   self->tipTimerPopup = XtAppAddTimeOut(
-      self->appContext,
+   _XscTimerStart(
+      self->timers,
+      &self->tipTimerPopup,
       XscTipGetPopupInterval( _XscObjectGetTip( object ) ),
       _popupTipTO,
       (XtPointer) object );
@@ -372,21 +721,21 @@ void _XscDisplayStartTimerSelectName( XscDisplay self, XscObject object )
 {
    unsigned int _interval;
    
-   if (self->tipTimerSelectName)
-   {
-      XtRemoveTimeOut( self->tipTimerSelectName );
-   }
-
    _interval = XscTipGetSelectNameInterval( _XscObjectGetTip( object ) );
    
    if (_interval != (unsigned long) -1)
    {
-      self->tipTimerSelectName = XtAppAddTimeOut(
-	 self->appContext,
+      _XscTimerStart(
+	 self->timers,
+	 &self->tipTimerSelectName,
 	 _interval,
 	 _selectNameTipTO,
 	 (XtPointer) object );
    }
+   else
+   {
+      _XscTimerCancel( self->timers, &self->tipTimerSelectName );
+   }
 }
 
 
@@ -410,23 +759,125 @@ static void _destroyDisplayCB( Widget w, XtPointer cd, XtPointer cbd )
       --------------------------------------------------------------*/
       XDeleteContext( 
          display->xDisplay, (XID)display->xDisplay, _displayContextId );
-         
-      XtFree( (char*) display );
+      _XscTopicTableForgetDisplay( display->xDisplay );
+      _XscTopicTableUnwatch( display->topics );
+      _XscDisplayUninstallEventDispatcher( display );
+
+      /*--------------------------------------------------------------
+      -- Records that still point to this one will release it later
+      --------------------------------------------------------------*/
+      display->closed = True;
+      if (display->referenceCount == 0)
+      {
+         _freeDisplay( display );
+      }
    }
 }
 
 
 /*------------------------------------------------------------------------------
--- This timer is called when the fast map interval for tips has expired
+-- This function releases the display record along with its record pools
 ------------------------------------------------------------------------------*/
-static void _cancelRestoreTO( XtPointer cd, XtIntervalId* not_used )
+static void _freeDisplay( XscDisplay self )
 {
-   XscDisplay self = (XscDisplay) cd;
+   int i;
    
-   self->tipTimerCancelRestore = (XtIntervalId) NULL;
+   if (self->cueMoveWorkProc)
+   {
+      XtRemoveWorkProc( self->cueMoveWorkProc );
+   }
 
-   self->tipRestoreGroupId = self->tipActiveGroupId = XmXSC_TIP_GROUP_NULL;
-   self->tipRestorePrimed  = False;
+   if (self->redrawWorkProc)
+   {
+      XtRemoveWorkProc( self->redrawWorkProc );
+   }
+   for (i = 0; i < self->redrawCount; i++)
+   {
+      XtRemoveCallback( 
+         self->redraws[ i ], XtNdestroyCallback, _forgetRedrawCB, self );
+   }
+   XtFree( (char*) self->redraws );
+
+   for (i = 0; i < XmXSC_POOL_COUNT; i++)
+   {
+      if (self->pools[ i ])
+      {
+         _XscPoolDestroy( self->pools[ i ] );
+      }
+   }
+   _XscTextTableDestroy( self->textTable );
+   _XscTopicTableDestroy( self->topics );
+   _XscTimerDestroy( self->timers );
+   XtFree( (char*) self );
+}
+
+
+/*------------------------------------------------------------------------------
+-- This work procedure clears the help windows waiting to be redrawn
+------------------------------------------------------------------------------*/
+static Boolean _redrawWP( XtPointer cd )
+{
+   XscDisplay self = (XscDisplay) cd;
+   Cardinal   i;
+
+   self->redrawWorkProc = (XtWorkProcId) NULL;
+
+   for (i = 0; i < self->redrawCount; i++)
+   {
+      Widget w = self->redraws[ i ];
+
+      XtRemoveCallback( w, XtNdestroyCallback, _forgetRedrawCB, self );
+
+      if (XtIsRealized( w ))
+      {
+         _XscDisplayIncrementCounter( self, XmXSC_COUNTER_REDRAWS_APPLIED );
+         XClearArea( self->xDisplay, XtWindow( w ), 0, 0, 0, 0, True );
+      }
+   }
+
+   if (self->redrawCount)
+   {
+      self->redrawCount = 0;
+      XFlush( self->xDisplay );
+   }
+   return True;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This callback takes a widget that is being destroyed off the redraw list
+------------------------------------------------------------------------------*/
+static void _forgetRedrawCB( Widget w, XtPointer cd, XtPointer not_used )
+{
+   XscDisplay self = (XscDisplay) cd;
+   Cardinal   i;
+
+   for (i = 0; i < self->redrawCount; i++)
+   {
+      if (self->redraws[ i ] == w)
+      {
+         self->redraws[ i ] = self->redraws[ --self->redrawCount ];
+         break;
+      }
+   }
+}
+
+
+/*------------------------------------------------------------------------------
+-- This work procedure moves the active cue to where its shell is now
+------------------------------------------------------------------------------*/
+static Boolean _moveCueWP( XtPointer cd )
+{
+   XscDisplay self = (XscDisplay) cd;
+
+   self->cueMoveWorkProc = (XtWorkProcId) NULL;
+
+   if (self->cueActive && !self->closed)
+   {
+      _XscDisplayIncrementCounter( self, XmXSC_COUNTER_CUE_MOVES_APPLIED );
+      _XscCuePopup( self->cueActive );
+   }
+   return True;
 }
 
 
@@ -434,16 +885,11 @@ static void _cancelRestoreTO( XtPointer cd, XtIntervalId* not_used )
 -- This timer is called when it is time for a tip to be automatically 
 -- popped-down
 ------------------------------------------------------------------------------*/
-static void _popdownTipTO( XtPointer cd, XtIntervalId* not_used )
+static void _popdownTipTO( XtPointer cd )
 {
    XscObject    xsc_object    = (XscObject) cd;
-   Widget       object_widget = _XscObjectGetWidget( xsc_object );
-   XscDisplay   self          = _XscDisplayDeriveFromWidget( object_widget );
+   XscDisplay   self          = _XscObjectGetDisplay( xsc_object );
 
-   assert( self );
-   
-   self->tipTimerPopdown = (XtIntervalId) NULL;
-   
    self->tipRestoreGroupId = self->tipActiveGroupId = XmXSC_TIP_GROUP_NULL;
    _XscTipPopdown( _XscObjectGetTip( xsc_object ) );
 }
@@ -453,32 +899,87 @@ static void _popdownTipTO( XtPointer cd, XtIntervalId* not_used )
 -- This timer is called when it is time for a tip to be automatically 
 -- popped-up
 ------------------------------------------------------------------------------*/
-static void _popupTipTO( XtPointer cd, XtIntervalId* not_used )
+static void _popupTipTO( XtPointer cd )
 {
    XscObject  object        = (XscObject) cd;
-   Widget     object_widget = _XscObjectGetWidget( object );
-   XscDisplay self          = _XscDisplayDeriveFromWidget( object_widget );
-   
-   assert( self );
-   
-   self->tipTimerPopup = (XtIntervalId) NULL;
 
    _XscTipPopup( _XscObjectGetTip( object ) );
 }
 
-static void _selectNameTipTO( XtPointer cd, XtIntervalId* not_used )
+static void _selectNameTipTO( XtPointer cd )
 {
    XscObject    xsc_object    = (XscObject) cd;
-   Widget       object_widget = _XscObjectGetWidget( xsc_object );
-   XscDisplay   self          = _XscDisplayDeriveFromWidget( object_widget );
+   XscDisplay   self          = _XscObjectGetDisplay( xsc_object );
 
-   assert( self );
-   
-   self->tipTimerSelectName = (XtIntervalId) NULL;
-   
    self->tipSelectedName = self->tipActive;
    
    _XscTipSelectName( _XscObjectGetTip( xsc_object ) );
 }
 
 
+
+/*==============================================================================
+                               Public functions
+==============================================================================*/
+/*------------------------------------------------------------------------------
+-- This function returns one of the event counters of the widget's display.
+-- It returns zero if the display or the counter is not known.
+------------------------------------------------------------------------------*/
+unsigned long XscHelpGetCounter( Widget w, int counter )
+{
+   XscDisplay self = _XscDisplayDeriveFromWidget( w );
+
+   if (!self || (counter < 0) || (counter >= XmXSC_COUNTER_COUNT))
+   {
+      return 0;
+   }
+   return self->counters[ counter ];
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function sets all event counters of the widget's display to zero
+------------------------------------------------------------------------------*/
+void XscHelpResetCounters( Widget w )
+{
+   XscDisplay self = _XscDisplayDeriveFromWidget( w );
+   int        i;
+
+   if (self)
+   {
+      for (i = 0; i < XmXSC_COUNTER_COUNT; i++)
+      {
+         self->counters[ i ] = 0;
+      }
+   }
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function reports the memory used by one of the help record pools
+-- of the widget's display.  It returns False if the display is not known.
+------------------------------------------------------------------------------*/
+Boolean XscHelpGetPoolStatistics( 
+   Widget                 w, 
+   int                    pool, 
+   XscHelpPoolStatistics* stats )
+{
+   XscDisplay self = _XscDisplayDeriveFromWidget( w );
+   
+   if (!self || (pool < 0) || (pool >= XmXSC_POOL_COUNT))
+   {
+      return False;
+   }
+   
+   if (self->pools[ pool ])
+   {
+      _XscPoolGetStatistics( self->pools[ pool ], stats );
+   }
+   else
+   {
+      memset( (char*) stats, '\0', sizeof( *stats ) );
+   }
+   return True;
+}
+
+
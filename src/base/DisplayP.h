@@ -26,6 +26,9 @@ typedef struct _XscDisplayRec *XscDisplay;
                               Private Includes
 ==============================================================================*/
 #include "ObjectP.h"
+#include "TextP.h"
+#include "TimerP.h"
+#include "TopicP.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,11 +38,18 @@ extern "C" {
 /*==============================================================================
                                     Macros
 ==============================================================================*/
+/*---------------------------------------------------------------------
+-- How long (ms) after leaving a shell the tip group is still active
+---------------------------------------------------------------------*/
+#define XscHelpDefaultTipRestoreInterval 100
 
 
 /*==============================================================================
                                Data types
 ==============================================================================*/
+#if XtVersion < 11006
+   typedef Boolean (*XtEventDispatchProc)( XEvent* );
+#endif
 
 
 /*==============================================================================
@@ -49,6 +59,29 @@ void  _XscDisplayInitialize( XContext );
 
 XscDisplay _XscDisplayCreate( Widget );
 XscDisplay _XscDisplayDeriveFromWidget( Widget );
+XscDisplay _XscDisplayDeriveFromDisplay( Display* );
+
+void _XscDisplayAddReference   ( XscDisplay );
+void _XscDisplayRemoveReference( XscDisplay );
+
+XtPointer _XscDisplayAllocRecord( XscDisplay, int, Cardinal );
+void      _XscDisplayFreeRecord ( XscDisplay, int, XtPointer );
+
+void _XscDisplayIncrementCounter( XscDisplay, int );
+
+unsigned long _XscDisplayGetDbGeneration( XscDisplay );
+void          _XscDisplayNotifyDbChanged( XscDisplay );
+
+XscTextTable _XscDisplayGetTextTable( XscDisplay );
+XscTimer     _XscDisplayGetTimers   ( XscDisplay );
+XscTopicTable _XscDisplayGetTopics  ( XscDisplay );
+
+Boolean _XscDisplayGetPointer  ( XscDisplay, Window, int*, int* );
+void    _XscDisplayTrackPointer( XscDisplay, Window, int,  int  );
+
+Boolean _XscDisplayDispatchEvent           ( XEvent* );
+Boolean _XscDisplayInstallEventDispatcher  ( XscDisplay, XtEventDispatchProc );
+void    _XscDisplayUninstallEventDispatcher( XscDisplay );
 
 Boolean _XscDisplayActiveTipGroupIdEquals ( XscDisplay, int );
 void    _XscDisplayCheckForTipGroupIdMatch( XscDisplay, int );
@@ -58,13 +91,17 @@ XscObject _XscDisplayGetActiveHint ( XscDisplay );
 XscObject _XscDisplayGetActiveTip  ( XscDisplay );
 XscObject _XscDisplayGetSelectedTip( XscDisplay );
 
-void _XscDisplayPrimeTipRestore( XscDisplay );
+void _XscDisplayExpireTipRestore( XscDisplay, Time );
+void _XscDisplayPrimeTipRestore ( XscDisplay, Time );
 
 void _XscDisplaySetActiveCue ( XscDisplay, XscCue    );
 void _XscDisplaySetActiveHint( XscDisplay, XscObject );
 void _XscDisplaySetActiveTip ( XscDisplay, XscObject );
 void _XscDisplaySetTipActiveGroupId( XscDisplay, int );
 
+void _XscDisplayRequestCueMove( XscDisplay );
+void _XscDisplayRequestRedraw ( XscDisplay, Widget );
+
 void _XscDisplayCancelTimerSelectName( XscDisplay );
 void _XscDisplayCancelTimerTipPopdown( XscDisplay );
 void _XscDisplayCancelTimerTipPopup  ( XscDisplay );
@@ -0,0 +1,351 @@
+/*------------------------------------------------------------------------------
+--  Help ToolKit for Motif
+--
+--  (c) Copyright 1997-1999, 2019 Robert S. Werner (a.k.a. Akiva Werner)
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+------------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <X11/IntrinsicP.h>
+
+#include "GridP.h"
+
+/*==============================================================================
+                               Private data types
+==============================================================================*/
+/*-------------------------------------------------------------------------
+-- A uniform grid over a composite.  Each cell lists the managed gadgets
+-- that overlap it, topmost (last child) first.  The lists are stored
+-- back to back in 'entries'; cell i uses entries[start[i]..start[i+1]).
+-------------------------------------------------------------------------*/
+typedef struct _XscGridRec
+{
+   Widget    composite;
+   Boolean   valid;
+   Boolean   overlapped;      /* Do any two gadgets overlap? */
+   int       width;
+   int       height;
+   int       columns;
+   int       rows;
+   int       cellWidth;
+   int       cellHeight;
+   Cardinal* start;
+   Cardinal  startSize;
+   Widget*   entries;
+   Cardinal  entriesSize;
+   Widget*   gadgets;         /* Scratch list used while building */
+   Cardinal  gadgetsSize;
+   Widget    lastHit;
+}
+XscGridRec;
+
+
+/*==============================================================================
+                               Private prototypes
+==============================================================================*/
+static void    _build      ( XscGrid );
+static Boolean _contains   ( Widget, int, int );
+static void    _cellRange  ( XscGrid, Widget, int*, int*, int*, int* );
+static Boolean _intersects ( Widget, Widget );
+
+
+/*==============================================================================
+                               Protected functions
+==============================================================================*/
+
+/*----------------------------------------------------------------------------
+-- This function creates an (empty) index for the gadgets of a composite
+------------------------------------------------------------------------------*/
+XscGrid _XscGridCreate( Widget composite )
+{
+   XscGrid self = XtNew( XscGridRec );
+
+   memset( (char*) self, '\0', sizeof( *self ) );
+   self->composite = composite;
+   self->valid     = False;
+
+   return self;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function releases the index
+------------------------------------------------------------------------------*/
+void _XscGridDestroy( XscGrid self )
+{
+   XtFree( (char*) self->start   );
+   XtFree( (char*) self->entries );
+   XtFree( (char*) self->gadgets );
+   XtFree( (char*) self );
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function marks the index out of date.  It is rebuilt on next use.
+------------------------------------------------------------------------------*/
+void _XscGridInvalidate( XscGrid self )
+{
+   self->valid   = False;
+   self->lastHit = NULL;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function returns the topmost managed gadget at (x,y), if any
+------------------------------------------------------------------------------*/
+Widget _XscGridFindGadget( XscGrid self, int x, int y )
+{
+   Cardinal cell;
+   Cardinal i;
+
+   if (!self->valid)
+   {
+      _build( self );
+   }
+
+   /*------------------------------------------------------------------
+   -- Consecutive motion events are usually inside the same gadget.
+   -- This shortcut is only safe if no other gadget can be on top.
+   ------------------------------------------------------------------*/
+   if (self->lastHit && !self->overlapped && _contains( self->lastHit, x, y ))
+   {
+      return self->lastHit;
+   }
+
+   if ((self->columns == 0) ||
+       (x < 0) || (x >= self->width) || (y < 0) || (y >= self->height))
+   {
+      return NULL;
+   }
+
+   cell = (y / self->cellHeight) * self->columns + (x / self->cellWidth);
+
+   for (i = self->start[ cell ]; i < self->start[ cell + 1 ]; i++)
+   {
+      Widget gadget = self->entries[ i ];
+
+      if (_contains( gadget, x, y ))
+      {
+         self->lastHit = gadget;
+         return gadget;
+      }
+   }
+   return NULL;
+}
+
+
+
+/*==============================================================================
+                               Private functions
+==============================================================================*/
+
+/*----------------------------------------------------------------------------
+-- This function rebuilds the grid from the composite's children
+------------------------------------------------------------------------------*/
+static void _build( XscGrid self )
+{
+   CompositeWidget mgr = (CompositeWidget) self->composite;
+   Cardinal        count = 0;
+   Cardinal        cells;
+   Cardinal        total;
+   Cardinal        i;
+   int             c, c0, c1, r, r0, r1;
+
+   /*--------------------------------------------------------------
+   -- Collect the managed gadgets, topmost (last child) first
+   --------------------------------------------------------------*/
+   if (self->gadgetsSize < mgr->composite.num_children)
+   {
+      self->gadgetsSize = mgr->composite.num_children;
+      self->gadgets     = (Widget*) XtRealloc(
+         (char*) self->gadgets, sizeof( Widget ) * self->gadgetsSize );
+   }
+
+   for (i = mgr->composite.num_children; i > 0; i--)
+   {
+      Widget child = mgr->composite.children[ i - 1 ];
+
+      if (child && !XtIsWidget( child ) && XtIsRectObj( child ) &&
+          XtIsManaged( child ))
+      {
+         self->gadgets[ count++ ] = child;
+      }
+   }
+
+   self->valid      = True;
+   self->overlapped = False;
+   self->lastHit    = NULL;
+   self->width      = self->composite->core.width;
+   self->height     = self->composite->core.height;
+
+   if ((count == 0) || (self->width <= 0) || (self->height <= 0))
+   {
+      self->columns = 0;
+      self->rows    = 0;
+      return;
+   }
+
+   /*------------------------------------------------------------------
+   -- Aim for about one gadget per cell, with cells shaped like the
+   -- composite itself
+   ------------------------------------------------------------------*/
+   self->columns = 1;
+   while ((Cardinal) (self->columns * self->columns) * self->height <
+          count * self->width)
+   {
+      self->columns += 1;
+   }
+   self->rows = (count + self->columns - 1) / self->columns;
+
+   self->cellWidth  = (self->width  + self->columns - 1) / self->columns;
+   self->cellHeight = (self->height + self->rows    - 1) / self->rows;
+
+   cells = self->columns * self->rows;
+   if (self->startSize < cells + 1)
+   {
+      self->startSize = cells + 1;
+      self->start     = (Cardinal*) XtRealloc(
+         (char*) self->start, sizeof( Cardinal ) * self->startSize );
+   }
+   memset( (char*) self->start, '\0', sizeof( Cardinal ) * (cells + 1) );
+
+   /*----------------------------------------------------
+   -- First pass: count the gadgets touching each cell
+   ----------------------------------------------------*/
+   for (i = 0; i < count; i++)
+   {
+      _cellRange( self, self->gadgets[ i ], &c0, &c1, &r0, &r1 );
+
+      for (r = r0; r <= r1; r++)
+      {
+         for (c = c0; c <= c1; c++)
+         {
+            self->start[ r * self->columns + c + 1 ] += 1;
+         }
+      }
+   }
+
+   for (i = 0; i < cells; i++)
+   {
+      self->start[ i + 1 ] += self->start[ i ];
+   }
+
+   total = self->start[ cells ];
+   if (self->entriesSize < total)
+   {
+      self->entriesSize = total;
+      self->entries     = (Widget*) XtRealloc(
+         (char*) self->entries, sizeof( Widget ) * self->entriesSize );
+   }
+
+   /*--------------------------------------------------------------
+   -- Second pass: fill the cells.  'start' is used as the fill
+   -- cursor and shifted back afterwards.
+   --------------------------------------------------------------*/
+   for (i = 0; i < count; i++)
+   {
+      Widget gadget = self->gadgets[ i ];
+
+      _cellRange( self, gadget, &c0, &c1, &r0, &r1 );
+
+      for (r = r0; r <= r1; r++)
+      {
+         for (c = c0; c <= c1; c++)
+         {
+            self->entries[ self->start[ r * self->columns + c ]++ ] = gadget;
+         }
+      }
+   }
+
+   for (i = cells; i > 0; i--)
+   {
+      self->start[ i ] = self->start[ i - 1 ];
+   }
+   self->start[ 0 ] = 0;
+
+   /*-------------------------------------------------------------
+   -- Gadgets sharing a cell are the only ones that can overlap
+   -------------------------------------------------------------*/
+   for (i = 0; (i < cells) && !self->overlapped; i++)
+   {
+      Cardinal j, k;
+
+      for (j = self->start[ i ]; j < self->start[ i + 1 ]; j++)
+      {
+         for (k = j + 1; k < self->start[ i + 1 ]; k++)
+         {
+            if (_intersects( self->entries[ j ], self->entries[ k ] ))
+            {
+               self->overlapped = True;
+            }
+         }
+      }
+   }
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function computes the cells covered by a gadget, clipped to the grid
+------------------------------------------------------------------------------*/
+static void _cellRange(
+   XscGrid self,
+   Widget  gadget,
+   int*    c0,
+   int*    c1,
+   int*    r0,
+   int*    r1 )
+{
+   int x0 = gadget->core.x;
+   int y0 = gadget->core.y;
+   int x1 = x0 + (int) gadget->core.width  - 1;
+   int y1 = y0 + (int) gadget->core.height - 1;
+
+   if (x0 < 0) x0 = 0;
+   if (y0 < 0) y0 = 0;
+   if (x1 >= self->width ) x1 = self->width  - 1;
+   if (y1 >= self->height) y1 = self->height - 1;
+
+   /*---------------------------------------------------
+   -- A gadget outside the composite covers no cells
+   ---------------------------------------------------*/
+   if ((x1 < x0) || (y1 < y0))
+   {
+      *c0 = 0; *c1 = -1;
+      *r0 = 0; *r1 = -1;
+      return;
+   }
+
+   *c0 = x0 / self->cellWidth;
+   *c1 = x1 / self->cellWidth;
+   *r0 = y0 / self->cellHeight;
+   *r1 = y1 / self->cellHeight;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function determines if a point is inside a gadget
+------------------------------------------------------------------------------*/
+static Boolean _contains( Widget gadget, int x, int y )
+{
+   return (x >= gadget->core.x                     ) &&
+          (x <  gadget->core.x + gadget->core.width ) &&
+          (y >= gadget->core.y                     ) &&
+          (y <  gadget->core.y + gadget->core.height);
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function determines if two gadgets overlap
+------------------------------------------------------------------------------*/
+static Boolean _intersects( Widget a, Widget b )
+{
+   return (a->core.x < b->core.x + b->core.width ) &&
+          (b->core.x < a->core.x + a->core.width ) &&
+          (a->core.y < b->core.y + b->core.height) &&
+          (b->core.y < a->core.y + a->core.height);
+}
@@ -0,0 +1,61 @@
+/*------------------------------------------------------------------------------
+--  Help ToolKit for Motif
+--
+--  (c) Copyright 1997-1999, 2019 Robert S. Werner (a.k.a. Akiva Werner)
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+------------------------------------------------------------------------------*/
+
+#ifndef __XscGridP_h
+#define __XscGridP_h
+
+
+#include <X11/Intrinsic.h>
+#include <Xm/Xm.h>
+
+
+/*==============================================================================
+                                   Handle
+==============================================================================*/
+typedef struct _XscGridRec *XscGrid;
+
+
+/*==============================================================================
+                              Private Includes
+==============================================================================*/
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+                                    Macros
+==============================================================================*/
+/*---------------------------------------------------------------------
+-- Composites with fewer gadgets than this are scanned linearly
+---------------------------------------------------------------------*/
+#define XscHelpGridGadgetThreshold 8
+
+
+/*==============================================================================
+                               Data types
+==============================================================================*/
+
+
+/*==============================================================================
+                                  Prototypes
+==============================================================================*/
+XscGrid _XscGridCreate ( Widget );
+void    _XscGridDestroy( XscGrid );
+
+Widget _XscGridFindGadget( XscGrid, int, int );
+void   _XscGridInvalidate( XscGrid );
+
+
+#ifdef __cplusplus
+}  /* Close scope of 'extern "C"' declaration which encloses file. */
+#endif
+
+#endif
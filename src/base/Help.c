@@ -11,6 +11,7 @@
 #include <ctype.h>
 #include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <X11/IntrinsicP.h>
@@ -27,7 +28,9 @@
 #include "ObjectP.h"
 #include "ScreenP.h"
 #include "ShellP.h"
+#include "TextP.h"
 #include "TipP.h"
+#include "TopicP.h"
 
 
 /*==============================================================================
@@ -59,7 +62,10 @@ enum
 /*==============================================================================
                             Private prototypes
 ==============================================================================*/
+static int  _compareWidgets( const void*, const void* );
 static void _createDisplayAndScreenRecords( Widget );
+static void _notifyDbChanged( Display* );
+static void _topicsChangedCB( XtPointer, XrmQuark*, Cardinal );
 
 
 /*==============================================================================
@@ -94,6 +100,18 @@ static Boolean  _tipsEnabled = True;
                                Private functions
 ==============================================================================*/
 
+/*------------------------------------------------------------------------------
+-- This function orders widgets so duplicates can be dropped
+------------------------------------------------------------------------------*/
+static int _compareWidgets( const void* a, const void* b )
+{
+   Widget _a = *(const Widget*) a;
+   Widget _b = *(const Widget*) b;
+
+   return (_a < _b) ? -1 : (_a > _b);
+}
+
+
 /*------------------------------------------------------------------------------
 -- This function creates the display/screen structures (if necessary)
 -- associated with a given widget/gadget
@@ -122,6 +140,76 @@ static void _createDisplayAndScreenRecords( Widget obj )
    }
 }
 
+
+/*------------------------------------------------------------------------------
+-- This function advances the resource database generation of a display, so
+-- help with autoDbReload set is reloaded when it is next activated
+------------------------------------------------------------------------------*/
+static void _notifyDbChanged( Display* x_display )
+{
+   XscDisplay _display = _XscDisplayDeriveFromDisplay( x_display );
+
+   if (_display)
+   {
+      _XscDisplayNotifyDbChanged( _display );
+   }
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function is called when watched topic files changed.  Only the 
+-- widgets whose help text refers to a changed topic are reloaded.  They 
+-- are collected first, since reloading them changes the references.
+------------------------------------------------------------------------------*/
+static void _topicsChangedCB( XtPointer cd, XrmQuark* names, Cardinal count )
+{
+   Display*      _display = (Display*) cd;
+   XscTopicTable _table   = _XscTopicTableDeriveFromDisplay( _display, True );
+   Widget*       _widgets = NULL;
+   Cardinal      _count   = 0;
+   Cardinal      _size    = 0;
+   Cardinal      _i, _j;
+
+   _notifyDbChanged( _display );
+
+   for (_i = 0; _i < count; _i++)
+   {
+      Cardinal   _references;
+      XtPointer* _reference = 
+         _XscTopicTableGetReferences( _table, names[ _i ], &_references );
+
+      for (_j = 0; _j < _references; _j++)
+      {
+         Widget _w = _XscTextGetWidget( (XscText) _reference[ _j ] );
+
+         if (!_w)
+         {
+            continue;
+         }
+         if (_count == _size)
+         {
+            _size    = _size ? _size * 2 : 16;
+            _widgets = (Widget*) XtRealloc( 
+               (char*) _widgets, sizeof( Widget ) * _size );
+         }
+         _widgets[ _count++ ] = _w;
+      }
+   }
+
+   qsort( _widgets, _count, sizeof( Widget ), _compareWidgets );
+
+   for (_i = 0; _i < _count; _i++)
+   {
+      if ((_i == 0) || (_widgets[ _i ] != _widgets[ _i - 1 ]))
+      {
+         XscHelpDbReload( _widgets[ _i ] );
+         XscHelpUpdate  ( _widgets[ _i ] );
+      }
+   }
+   XtFree( (char*) _widgets );
+}
+
+
 
 /*==============================================================================
                             Protected functions
@@ -200,16 +288,31 @@ void _XscHelpInstallOnWidget( Widget obj )
 	 -- finished and then do the kids.  This avoids some nasty
 	 -- problems of inheritance, because otherwise the kid
 	 -- has no htk records from which to inherit.
+	 -- The sparse registry leaves ancestors without records, so
+	 -- it cannot wait; a child then inherits from the nearest
+	 -- recorded ancestor.
 	 ---------------------------------------------------------*/
-	 if (_parentObject || XtIsShell( _parent ))
+	 if (_parentObject || XtIsShell( _parent ) || 
+	     XscHelpIsSparseRegistryActive())
 	 {
-	    _XscObjectCreate( obj );
+	    htk_object = _XscObjectCreate( obj );
+	    
+	    /*-----------------------------------------------------------
+	    -- A gadget needs its parent to track the pointer for it.
+	    -- The gadget is recorded first so the parent counts it.
+	    -----------------------------------------------------------*/
+	    if (!_parentObject && !XtIsShell( _parent ) && !XtIsWidget( obj ))
+	    {
+	       _XscObjectPromote( _parent );
+	    }
 	    
 	    /*----------------------------------------------------------
 	    -- If it is a composite, there may be some children that
-	    -- were "created" -- but not registered -- earlier
+	    -- were "created" -- but not registered -- earlier.  In
+	    -- sparse mode, children a composite creates while it is
+	    -- initialized are already registered.
 	    ----------------------------------------------------------*/
-	    if (XtIsComposite( obj )) 
+	    if (htk_object && XtIsComposite( obj )) 
 	    {
 	       CompositeRec* _cr = (CompositeRec*) obj;
 	       if (((int) _cr->composite.num_children) > 0)
@@ -218,7 +321,10 @@ void _XscHelpInstallOnWidget( Widget obj )
 		  for (i = 0; i < _cr->composite.num_children; i++)
 		  {
 	             Widget _kid = _cr->composite.children[ i ];
-		     _XscObjectCreate( _kid );
+		     if (!_XscObjectDeriveFromWidget( _kid ))
+		     {
+			_XscObjectCreate( _kid );
+		     }
 		  }
 	       }
 	    }
@@ -609,141 +715,73 @@ void XscHelpInstall( Widget shell )
 }
 
 /*------------------------------------------------------------------------------
--- This function loads "global" topics into the resource database.  There is
--- a very simple parsing rule
+-- This function loads "global" topics for a display.  There is a very simple
+-- parsing rule: a line starting with ".TEXT[name]" begins the topic "name" 
+-- and a line starting with ".END" (or the next ".TEXT[") ends it.  The topics
+-- are kept in a table of their own rather than in the display's resource
+-- database, so they do not slow down every other resource lookup.
 ------------------------------------------------------------------------------*/
 int XscHelpLoadTopics( Display* theDisplay, const char* theFilename )
 {
-   int _result = 0;
-   
-   FILE* _file = fopen( theFilename, "r" );
-   
-   if (_file)
+   int _result = _XscTopicTableLoadFile( 
+      _XscTopicTableDeriveFromDisplay( theDisplay, True ), theFilename );
+
+   if (_result == 0)
    {
-      char    _specifier [  256 ];
-      char    _lineBuffer[ 1024 ];
-      char*   _ptr;
-      char*   _topicBuffer     = NULL;
-      int     _topicBufferSize = 0;
-      int     _topicLen        = 0;
-      char*   _topicEnd        = NULL;
-      
-      XrmDatabase _db = XrmGetDatabase( theDisplay );
-      
-      Boolean _inTopic = False;
-      
-      _topicBufferSize = sizeof( _lineBuffer );
-      _topicBuffer = XtMalloc( _topicBufferSize );
-      _topicLen    = 0;
-      _topicEnd    = _topicBuffer;
-      
-      *_topicBuffer = '\0';
-      
-      while (!feof( _file ))
-      {
-      	 _ptr = fgets( _lineBuffer, sizeof( _lineBuffer ), _file );
-	 if (_ptr)
-	 {
-	    if (strncmp( _ptr, ".TEXT[", 6 ) == 0)
-	    {
-	       char* _walk;
-	       char* _end;
-	       
-	       _ptr += 6;
-	       _walk = _ptr;
-	       
-	       while (*_walk)
-	       {
-	          if (!isspace( *_walk )) break;
-		  
-		  _ptr++;
-		  _walk++;
-	       }
-	       
-	       _end = NULL;
-	       while (*_walk)
-	       {
-	          if (isspace( *_walk ))
-		  {
-		     _end = _walk;
-		  }
-		  else if (*_walk == ']')
-		  {
-		     if (_end == NULL) _end = _walk;
-		     break;
-		  }
-		  else
-		  {
-		     _end = NULL;
-		  }
-		  _walk++;
-	       }
-	       *_end = '\0';
-	       
-	       if (_inTopic)
-	       {
-		  if (_topicLen)
-		  {
-	             _topicEnd--;
-		     if (*_topicEnd == '\n') *_topicEnd = '\0';
-		  }
-	       
-		  XrmPutStringResource(
-	             &_db, _specifier, _topicBuffer );
-	       
-		  *_topicBuffer = '\0';
-		  _topicEnd = _topicBuffer;
-		  _topicLen = 0;
-	       }
-	       sprintf( _specifier, "_xscHelp.topic.%s", _ptr );
-	       _inTopic = True;
-	    }
-	    else if (strncmp( _ptr, ".END", 4 ) == 0)
-	    {
-	       if (_topicLen)
-	       {
-	          _topicEnd--;
-		  if (*_topicEnd == '\n') *_topicEnd = '\0';
-	       }
-	       
-	       XrmPutStringResource(
-	          &_db, _specifier, _topicBuffer );
-		  
-	       _inTopic = False;
-	       *_topicBuffer = '\0';
-	       _topicEnd = _topicBuffer;
-	       _topicLen = 0;
-	    }
-	    else
-	    {
-	       if (_inTopic)
-	       {
-		  int _lineLen = strlen( _ptr );
-		  if (_topicLen + _lineLen >= _topicBufferSize)
-		  {
-		     _topicBufferSize = _topicLen + _lineLen + 1024;
-		     
-		     _topicBuffer = XtRealloc( _topicBuffer, _topicBufferSize );
-		     _topicEnd = _topicBuffer + _topicLen;
-		  }
-		  strcpy( _topicEnd, _ptr );
-		  _topicEnd += _lineLen;
-		  _topicLen += _lineLen;
-	       }
-	    }
-	 }
-      }
-      XtFree( _topicBuffer );
-      fclose( _file );
+      _notifyDbChanged( theDisplay );
    }
-   else
+   return _result;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function loads a topic catalog compiled with xsccatalog(1).  The
+-- catalog is mapped into memory and the topics are used from there, so
+-- applications using the same catalog share a single copy of it.  Topics
+-- loaded with XscHelpLoadTopics() take precedence over catalog topics.
+------------------------------------------------------------------------------*/
+int XscHelpLoadTopicCatalog( Display* theDisplay, const char* theFilename )
+{
+   int _result = _XscTopicTableLoadCatalog( 
+      _XscTopicTableDeriveFromDisplay( theDisplay, True ), theFilename );
+
+   if (_result == 0)
    {
-      _result = errno;
+      _notifyDbChanged( theDisplay );
    }
    return _result;
 }
 
 
+/*------------------------------------------------------------------------------
+-- This function tells the library the resource database of the widget's
+-- display was changed, for example with XrmPutResource().  Help with 
+-- autoDbReload set is reloaded the next time it is activated; until then,
+-- activating it does not reload its resources.
+------------------------------------------------------------------------------*/
+void XscHelpNotifyDbChanged( Widget aWidget )
+{
+   _notifyDbChanged( XtDisplayOfObject( aWidget ) );
+}
+
+/*------------------------------------------------------------------------------
+-- This function watches the topic files loaded for the widget's display.
+-- When one is written, it is loaded again and the help of the widgets 
+-- using a topic that changed is updated.  It returns 0, or ENOSYS where 
+-- files cannot be watched.  Topic catalogs are not watched.
+------------------------------------------------------------------------------*/
+int XscHelpWatchTopics( Widget aWidget )
+{
+   Display* _display = XtDisplayOfObject( aWidget );
+
+   return _XscTopicTableWatch( 
+      _XscTopicTableDeriveFromDisplay( _display, True ), 
+      XtWidgetToApplicationContext( aWidget ), 
+      _topicsChangedCB, 
+      (XtPointer) _display );
+}
+
+
 Boolean XscHelpAreCuesDisplayable( Widget aWidget )
 {
    if (_cuesEnabled)
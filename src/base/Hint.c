@@ -18,6 +18,8 @@
 
 #include "DisplayP.h"
 #include "HintP.h"
+#include "ResourceP.h"
+#include "ScreenP.h"
 #include "ShellP.h"
 
 
@@ -38,9 +40,11 @@ typedef struct _XscHintRec
    Pixel      foreground;
    Boolean    inheritBackground; /* Use same background as parent? */
    Boolean    autoDbReload;
+   unsigned long dbGeneration;   /* When the resources were loaded */
    Boolean    enabled;
    Boolean    motifColorModel;
    Boolean    compound;
+   XscScreenColorsRec _colors;   /* Derived from the last background */
 }
 XscHintRec;
 
@@ -48,9 +52,9 @@ XscHintRec;
 
 XscHint _XscHintCreate( XscObject o )
 {
-   XscHint self = XtNew( XscHintRec );
+   XscHint self = (XscHint) _XscDisplayAllocRecord( 
+      _XscObjectGetDisplay( o ), XmXSC_POOL_HINT, sizeof( XscHintRec ) );
    
-   memset( (void*) self, '\0', sizeof( *self ) );
    self->text   = NULL;
    self->object = o;
 
@@ -60,7 +64,8 @@ XscHint _XscHintCreate( XscObject o )
 void _XscHintDestroy( XscHint self )
 {
    if (self->text) _XscTextDestroy( self->text );
-   XtFree( (char*) self );
+   _XscDisplayFreeRecord( 
+      _XscObjectGetDisplay( self->object ), XmXSC_POOL_HINT, (XtPointer) self );
 }
 
 
@@ -130,11 +135,11 @@ void _XscHintLoadResources( XscHint self, XscText text )
 
    Widget w = _XscObjectGetWidget( self->object );
    
-   XtGetApplicationResources( 
-      w,
-      self, 
-      resource,   (Cardinal) XtNumber( resource ),
-      NULL,       (Cardinal) 0 );
+   _XscResourceGetValues( 
+      w, (XtPointer) self, resource, (Cardinal) XtNumber( resource ) );
+   
+   self->dbGeneration = 
+      _XscDisplayGetDbGeneration( _XscObjectGetDisplay( self->object ) );
    
    if (text)
    {
@@ -151,7 +156,8 @@ void _XscHintLoadResources( XscHint self, XscText text )
    {
       if (self->text == NULL)
       {
-         self->text = _XscTextCreate();
+         self->text = 
+            _XscTextCreate( _XscObjectGetDisplay( self->object ) );
       }
       _XscTextLoadHintResources( self->text, w, NULL );
    }
@@ -166,7 +172,7 @@ void _XscHintActivate( XscHint self )
    -- Make sure that the shell associated with this object actually 
    -- has a hint display widget defined
    ----------------------------------------------------------------*/
-   shell = _XscShellDeriveFromWidget( _XscObjectGetWidget( self->object ) );
+   shell = _XscObjectGetShell( self->object );
    
    if (shell && _XscShellIsHintDisplayable( shell ))
    {
@@ -174,7 +180,7 @@ void _XscHintActivate( XscHint self )
 
       if (hint_widget)
       {
-         XscDisplay display = _XscDisplayDeriveFromWidget( hint_widget );
+         XscDisplay display = _XscShellGetDisplay( shell );
          
          /*----------------------------------------------------
          -- This object is now the active hint on the display
@@ -183,10 +189,12 @@ void _XscHintActivate( XscHint self )
 
          /*---------------------------------------------------------------
          -- If the hint needs to be dynamically updated, then reload its
-         -- attributes from the resource database
+         -- attributes once the resource database has changed
          ---------------------------------------------------------------*/
-         if (self->autoDbReload)
+         if (self->autoDbReload && 
+             (self->dbGeneration != _XscDisplayGetDbGeneration( display )))
          {
+            _XscDisplayIncrementCounter( display, XmXSC_COUNTER_DB_RELOADS );
             _XscHintLoadResources( self, NULL );
          }
 
@@ -248,8 +256,7 @@ void _XscHintRender( XscHint self, Widget hint_widget, GC gc, Pixel background )
    {
       Display* x_display = XtDisplay( hint_widget );
 
-      Pixel foreground_color, select_color;
-      Pixel top_shadow_color, bottom_shadow_color;
+      Pixel foreground_color;
 
       /*---------------------
       -- Keeps the GC happy
@@ -261,14 +268,13 @@ void _XscHintRender( XscHint self, Widget hint_widget, GC gc, Pixel background )
       ----------------------------------------------*/
       if (self->motifColorModel)
       {
-         XmGetColors(
-            XtScreen( hint_widget ),
+         _XscScreenGetColors(
+            _XscObjectGetScreen( self->object ),
             hint_widget->core.colormap,
             background,
-            &foreground_color,
-            &top_shadow_color,
-            &bottom_shadow_color,
-            &select_color );
+            &self->_colors );
+
+         foreground_color = self->_colors.foreground;
       }
       else
       {
@@ -364,7 +370,7 @@ void XscHintSetAlignment( XscHint self, unsigned char a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( self->object );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -374,7 +380,7 @@ void XscHintSetFontList( XscHint self, XmFontList a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( self->object );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -384,7 +390,7 @@ void XscHintSetFontListTag( XscHint self, String a, Boolean u )
    if (u)
    {
       Widget w = _XscObjectGetWidget( self->object );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }
 }
 
@@ -404,7 +410,7 @@ void XscHintSetStringConverter( XscHint self, unsigned char a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( self->object );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -414,7 +420,7 @@ void XscHintSetStringDirection( XscHint self, unsigned char a, Boolean u )
    if (u)                              
    {
       Widget w = _XscObjectGetWidget( self->object );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -422,7 +428,7 @@ void XscHintSetTopic( XscHint self, String a )
 {
    Widget w = _XscObjectGetWidget( self->object ); 
    _XscTextSetTopic( self->text, XtNewString( a ) );
-   _XscTextCreateCompoundString( self->text, w );
+   _XscTextMarkDirty( self->text, w );
 }
 
 
@@ -120,6 +120,7 @@ HtkGadgetClassExtension, *HtkGadgetClassExtensionPtr;
 
 #else
 
+   static void _changeHook( Widget, XtPointer, XtPointer );
    static void _createHook( Widget, XtPointer, XtPointer );
 
 #endif
@@ -381,6 +382,36 @@ static XrmQuark _gadgetClassExtensionQuark = NULLQUARK;
 
 #else
 
+   /*---------------------------------------------------------------------------
+   -- This function is called in X11R6+ when a widget is changed.  Any
+   -- change may move, resize, or (un)manage gadgets, so the gadget index
+   -- of the widget and its parent is dropped.  Changes to the events the
+   -- widget selects may change how the library gets them.
+   ---------------------------------------------------------------------------*/
+   static void _changeHook( Widget obj, XtPointer cd, XtPointer cbd )
+   {
+      XtChangeHookData data = (XtChangeHookData) cbd;
+      String           type = data->type;
+
+      _XscObjectInvalidateGadgetIndex( data->widget );
+
+      if (strcmp( type, XtHrealizeWidget ) == 0)
+      {
+         _XscObjectRealized( data->widget );
+      }
+      else if ((strcmp( type, XtHaugmentTranslations   ) == 0) ||
+               (strcmp( type, XtHoverrideTranslations  ) == 0) ||
+               (strcmp( type, XtHuninstallTranslations ) == 0))
+      {
+         _XscObjectUpdateDispatch( data->widget, True );
+      }
+      else if (strcmp( type, XtHsetValues ) == 0)
+      {
+         _XscObjectUpdateDispatch( data->widget, False );
+      }
+   }
+
+
    /*---------------------------------------------------------------------------
    -- This function is called in X11R6+ to notify the library that a 
    -- widget/gadget was created
@@ -449,12 +480,12 @@ static void _inputDispatchGadgetHook( Widget w, XEvent* e, Mask m )
    if (m & XmFOCUS_IN_EVENT)
    {
       XscObject object = _XscObjectDeriveFromWidget( w );
-      _XscObjectGadgetFocusIn( object );
+      if (object) _XscObjectGadgetFocusIn( object );
    }
    else if (m & XmFOCUS_OUT_EVENT)
    {
       XscObject object = _XscObjectDeriveFromWidget( w );
-      _XscObjectGadgetFocusOut( object );
+      if (object) _XscObjectGadgetFocusOut( object );
    }
 #if 0
    else if (m & XmENTER_EVENT)
@@ -540,6 +571,7 @@ void _XscHooksInstall( Widget shell )
          display_hook = XtHooksOfDisplay( XtDisplay( shell ) );
          
          XtAddCallback( display_hook, XtNcreateHook, _createHook, NULL );
+         XtAddCallback( display_hook, XtNchangeHook, _changeHook, NULL );
       }
 
 #  endif
@@ -22,9 +22,11 @@
 
 #include "CueP.h"
 #include "DisplayP.h"
+#include "GridP.h"
 #include "HelpP.h"
 #include "HintP.h"
 #include "ObjectP.h"
+#include "ResourceP.h"
 #include "ScreenP.h"
 #include "ShellP.h"
 #include "TextP.h"
@@ -39,57 +41,61 @@
 typedef struct _XscObjectRec
 {
    Widget       object;
+   XscDisplay   display;            /* Cached records of this object's... */
+   XscScreen    screen;             /* ...display, screen, and WM shell */
+   XscShell     shell;
    XFontStruct* font;	      	    /* Font to use if no font list is found */
    int          tipGroupId;
    Boolean      hasGroupLeader;
    Cardinal     gadgetChildCount;   /* How many gadget children are there? */
+   Cardinal     helpGadgetCount;    /* ...and how many have a hint or tip? */
+   Boolean      hasGadgetHelp;      /* Is this gadget in its parent's count? */
+   Boolean      motionSelected;     /* Is the motion handler installed? */
+   Boolean      motionHint;         /* Ask for hinted motion events? */
    Boolean      gadgetProcessing;    /* Should gadgets be monitored? */
+   Boolean      loaded;             /* Are cue, hint, and tip loaded? */
+   Boolean      dispatched;         /* Events come via the dispatcher? */
+   Window       window;             /* As entered for the dispatcher */
    XscObject    activeGadget;
+   XscGrid      gadgetIndex;        /* Spatial index of gadget children */
    XscTip       tip;
    XscHint      hint;
    XscCue       cue;
    XscCue       cueSubstitute;
 }
 XscObjectRec;
-
-XscCue  _XscObjectGetCue       ( XscObject self ) { return self->cue;        }
-Font    _XscObjectGetFont      ( XscObject self ) { return self->font->fid;  }
-XscTip  _XscObjectGetTip       ( XscObject self ) { return self->tip;        }
-XscHint _XscObjectGetHint      ( XscObject self ) { return self->hint;       }
-Widget  _XscObjectGetWidget    ( XscObject self ) { return self->object;     }
-int     _XscObjectGetTipGroupId( XscObject self ) { return self->tipGroupId; }
-
-void _XscObjectSetTipGroupId( XscObject self, int id ) { self->tipGroupId=id; }
-
-Boolean _XscObjectHasValidCue( XscObject self )
-{
-   return self->cue && XscCueHasValidTopic( self->cue );
-}
-Boolean _XscObjectHasValidHint( XscObject self )
-{
-   return self->hint && XscHintHasValidTopic( self->hint );
-}
-Boolean _XscObjectHasValidTip( XscObject self )
-{
-   return self->tip && XscTipHasValidTopic( self->tip );
-}
 
 /*==============================================================================
                             Private prototypes
 ==============================================================================*/
+static Cardinal  _countGadgetChildren( Widget );
+static Cardinal  _countHelpGadgetChildren( Widget );
+static XscObject _createObject      ( Widget, Boolean );
+static Boolean   _cueInScope        ( Widget );
 static void _destroyObjectCB     ( Widget, XtPointer, XtPointer );
+static void _discardObject       ( XscObject );
+static Boolean _dispatchEvent    ( XEvent* );
+static void _dispatchRealized    ( Widget );
+static Widget  _gadgetAt         ( XscObject, int, int );
 static void _enterObjectCue      ( XscObject, int );
 static void _enterObjectHint     ( XscObject, int );
 static void _enterObjectTip      ( XscObject, int );
 static void _enterOrLeaveObjectEH( Widget, XtPointer, XEvent*, Boolean* );
+static void _enterWindow         ( XscObject );
 static void _focusChangeEH       ( Widget, XtPointer, XEvent*, Boolean* );
+static int  _implicitTipGroupId  ( Widget );
 static void _leaveObject         ( XscObject, Boolean );
 static void _leaveObjectCue      ( XscObject, int );
+static void _loadObject          ( XscObject );
 static void _motionInObjectEH    ( Widget, XtPointer, XEvent*, Boolean* );
+static Boolean _needsRecord      ( XscObject, Boolean );
 static void _setupHint           ( XscObject, const char* );
 static void _setupCue            ( XscObject, const char* );
-static void _setupObject         ( XscObject );
+static Boolean _setupObject      ( XscObject, Boolean* );
 static void _setupTip            ( XscObject, const char* );
+static void _selectDispatch      ( XscObject );
+static void _selectGadgetMotion  ( XscObject );
+static void _syncGadgetHelp      ( XscObject );
 static void _updateCue           ( XscObject, XscDisplay );
 static void _updateHint          ( XscObject, XscDisplay );
 static void _updateTip           ( XscObject, XscDisplay );
@@ -104,6 +110,11 @@ static void _updateTip           ( XscObject, XscDisplay );
 -----------------------------------------------------------------------*/
 static XContext _objectContextId;
 
+/*-----------------------------------------------------------------------
+-- With central dispatch, records are also found through their window
+-----------------------------------------------------------------------*/
+static XContext _windowContextId;
+
 /*---------------------------------------------------------------------------
 -- This variable controls if the tip group default is the original 
 -- (default is static XmXSC_TIP_GROUP_PARENT) or the new dynamic
@@ -114,6 +125,97 @@ static Boolean __smartGroupDefault = True;
 
 Boolean XscHelpIsDynamicTipGroupIdDefaultActive() {return __smartGroupDefault;}
 void XscHelpSetDynamicTipGroupDefault( Boolean b ) { __smartGroupDefault = b; }
+
+/*---------------------------------------------------------------------------
+-- This variable is the default value of the xscLazyLoad resource.  A lazy
+-- object record only loads its tip group data when it is created.  Its
+-- cue, hint, and tip are loaded the first time the pointer enters it, it
+-- receives the focus, or the application asks for them.
+---------------------------------------------------------------------------*/
+static Boolean __lazyLoad = False;
+
+Boolean XscHelpIsLazyLoadActive() { return __lazyLoad; }
+void XscHelpSetLazyLoad( Boolean b ) { __lazyLoad = b; }
+
+/*---------------------------------------------------------------------------
+-- This variable controls the sparse registry.  When active, a widget only
+-- keeps a record (and event handlers) if it has a cue, hint, or tip, an
+-- explicit tip group, gadget children, or an ancestor with a cue.  Other
+-- widgets are examined once and forgotten; inheritance goes through the
+-- nearest recorded ancestor instead.  Widgets are always loaded eagerly
+-- in this mode, since their help decides if a record is kept.
+---------------------------------------------------------------------------*/
+static Boolean __sparseRegistry = False;
+
+Boolean XscHelpIsSparseRegistryActive() { return __sparseRegistry; }
+void XscHelpSetSparseRegistry( Boolean b ) { __sparseRegistry = b; }
+
+/*---------------------------------------------------------------------------
+-- This variable controls central dispatch.  When active, crossing and
+-- focus events are handled by one dispatcher per display instead of two
+-- event handlers per widget.  It needs X11R6 and only affects widgets
+-- created or changed after it is set.
+---------------------------------------------------------------------------*/
+static Boolean __centralDispatch = False;
+
+Boolean XscHelpIsCentralDispatchActive() { return __centralDispatch; }
+void XscHelpSetCentralDispatch( Boolean b ) { __centralDispatch = b; }
+
+/*-----------------------------------------------------------------------
+-- Accessing the cue, hint, or tip of a lazy object forces it to load
+-----------------------------------------------------------------------*/
+XscCue _XscObjectGetCue( XscObject self )
+{
+   _loadObject( self );
+   return self->cue;
+}
+XscHint _XscObjectGetHint( XscObject self )
+{
+   _loadObject( self );
+   return self->hint;
+}
+XscTip _XscObjectGetTip( XscObject self )
+{
+   _loadObject( self );
+   return self->tip;
+}
+
+XscDisplay _XscObjectGetDisplay( XscObject self ) { return self->display; }
+XscScreen  _XscObjectGetScreen ( XscObject self ) { return self->screen;  }
+
+XscShell _XscObjectGetShell( XscObject self )
+{
+   /*-------------------------------------------------------------
+   -- The shell record may not exist yet when the object is made
+   -------------------------------------------------------------*/
+   if (!self->shell)
+   {
+      self->shell = _XscShellDeriveFromWidget( self->object );
+   }
+   return self->shell;
+}
+
+Font    _XscObjectGetFont      ( XscObject self ) { return self->font->fid;  }
+Widget  _XscObjectGetWidget    ( XscObject self ) { return self->object;     }
+int     _XscObjectGetTipGroupId( XscObject self ) { return self->tipGroupId; }
+
+void _XscObjectSetTipGroupId( XscObject self, int id ) { self->tipGroupId=id; }
+
+Boolean _XscObjectHasValidCue( XscObject self )
+{
+   _loadObject( self );
+   return self->cue && XscCueHasValidTopic( self->cue );
+}
+Boolean _XscObjectHasValidHint( XscObject self )
+{
+   _loadObject( self );
+   return self->hint && XscHintHasValidTopic( self->hint );
+}
+Boolean _XscObjectHasValidTip( XscObject self )
+{
+   _loadObject( self );
+   return self->tip && XscTipHasValidTopic( self->tip );
+}
 
 /*==============================================================================
                                Protected functions
@@ -133,30 +235,78 @@ void _XscObjectInitialize( XContext context )
       {
          _objectContextId = XUniqueContext();
       }
+      _windowContextId = XUniqueContext();
    }
 }
 
 
 /*------------------------------------------------------------------------------
--- Every object needs a light-weight record for generic information
+-- Every object needs a light-weight record for generic information.  In
+-- sparse mode, NULL is returned for objects that do not need one.
 ------------------------------------------------------------------------------*/
 XscObject _XscObjectCreate( Widget obj )
 {
-   XscObject self;
-   Display*  x_display = XtDisplayOfObject( obj );
+   return _createObject( obj, False );
+}
 
-   /*------------------------------------
-   -- Make a Help ToolKit object record
-   ------------------------------------*/
-   self = XtNew( XscObjectRec );
+
+/*------------------------------------------------------------------------------
+-- This function returns an object's record, creating it if the sparse
+-- registry skipped the object earlier
+------------------------------------------------------------------------------*/
+XscObject _XscObjectPromote( Widget obj )
+{
+   XscObject self = _XscObjectDeriveFromWidget( obj );
+
+   if (!self && __sparseRegistry && !XtIsShell( obj ))
+   {
+      if (_XscDisplayDeriveFromWidget( obj ) && 
+          _XscScreenDeriveFromWidget ( obj ))
+      {
+         self = _createObject( obj, True );
+      }
+   }
+   return self;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function creates an object record.  Unless forced, the record is
+-- dropped again in sparse mode if it turns out not to be needed.
+------------------------------------------------------------------------------*/
+static XscObject _createObject( Widget obj, Boolean forced )
+{
+   XscObject  self;
+   XscDisplay display = _XscDisplayDeriveFromWidget( obj );
+   Boolean    lazy;
+   Boolean    explicit_group;
+   Display*   x_display = XtDisplayOfObject( obj );
+
+   /*------------------------------------------------------------
+   -- Make a Help ToolKit object record from the display's pool
+   ------------------------------------------------------------*/
+   assert( display );
+   self = (XscObject) _XscDisplayAllocRecord( 
+      display, XmXSC_POOL_OBJECT, sizeof( XscObjectRec ) );
 
    /*----------------------
    -- Initialize 
    ----------------------*/
    self->object           = obj;
+   self->display          = display;
+   self->screen           = _XscScreenDeriveFromWidget ( obj );
+   self->shell            = _XscShellDeriveFromWidget  ( obj );
    self->gadgetChildCount = 0;
+   self->helpGadgetCount  = 0;
+   self->hasGadgetHelp    = False;
+   self->motionSelected   = False;
+   self->motionHint       = False;
    self->gadgetProcessing = True;
+   self->loaded           = False;
    self->activeGadget     = NULL;
+   self->gadgetIndex      = NULL;
+   self->dispatched       = False;
+   self->window           = None;
    self->cue              = NULL;
    self->cueSubstitute    = NULL;
    self->hint             = NULL;
@@ -164,20 +314,43 @@ XscObject _XscObjectCreate( Widget obj )
    self->tipGroupId       = XmXSC_TIP_GROUP_NULL;
    self->hasGroupLeader   = False;
 
-   /*-------------------------------------------------
-   -- Load object members from the resource database
-   -------------------------------------------------*/
-   _setupObject( self );
+   /*------------------------------------------------------------------
+   -- The display and screen records must outlive this one because
+   -- the event handlers use these pointers instead of the X context
+   -- manager.  Xt destroys the shell after this object, so the shell
+   -- record does not need the same protection.
+   ------------------------------------------------------------------*/
+   assert( self->display && self->screen );
+   _XscDisplayAddReference( self->display );
+   _XscScreenAddReference ( self->screen  );
+
+   /*-------------------------------------------------------------------
+   -- Load object members from the resource database.  This includes
+   -- the xscLazyLoad resource, which controls when the rest is loaded.
+   -------------------------------------------------------------------*/
+   _XscResourceBegin( obj );
+   lazy = _setupObject( self, &explicit_group );
 
    /*----------------------------------------------------------------------
    -- Determine if this object has an associated tip and/or hint.  If so,
    -- create and populate the associated data structures.  The new
    -- structures are bound to the object structure via the hint/tip
-   -- members.
+   -- members.  A lazy object postpones this until it is first used,
+   -- except in sparse mode, where the help decides if the record is kept.
+   -- Gadgets are never lazy: their help decides if the parent has to
+   -- watch pointer motion.
    ----------------------------------------------------------------------*/
-   _setupCue ( self, NULL );
-   _setupHint( self, NULL );
-   _setupTip ( self, NULL );
+   if (!lazy || __sparseRegistry || !XtIsWidget( obj ))
+   {
+      _loadObject( self );
+   }
+   _XscResourceEnd( obj );
+
+   if (__sparseRegistry && !forced && !_needsRecord( self, explicit_group ))
+   {
+      _discardObject( self );
+      return NULL;
+   }
 
    /*------------------------------------------------------
    -- The library needs to track when the pointer moves 
@@ -188,20 +361,8 @@ XscObject _XscObjectCreate( Widget obj )
    ------------------------------------------------------*/
    if (XtIsWidget( obj ))
    {
-      XtAddEventHandler( 
-         obj, 
-         EnterWindowMask | LeaveWindowMask,
-         False,
-         _enterOrLeaveObjectEH,
-         (XtPointer) self );
-         
-       XtAddEventHandler( 
-         obj, 
-         FocusChangeMask,
-         False,
-         _focusChangeEH,
-         (XtPointer) self );
-  }
+      _selectDispatch( self );
+   }
 
    XSaveContext( x_display, (XID)obj, _objectContextId, (XPointer)self );
 
@@ -213,7 +374,8 @@ XscObject _XscObjectCreate( Widget obj )
    /*--------------------------------------------------------------------
    -- Keep track of the number of gadgets maintained by each composite.
    -- This is used to activate gadget managment only when gadgets are
-   -- present.
+   -- present.  The pointer motion handler is only installed while at
+   -- least one of them has a hint or tip (see _syncGadgetHelp).
    --
    -- In some cases, a gadget may be "created" before its parent.  This
    -- will happen when gadgets are used to create a single "compound"
@@ -225,40 +387,10 @@ XscObject _XscObjectCreate( Widget obj )
    ---------------------------------------------------------------------*/
    if (XtIsComposite( obj ))
    {
-      CompositeWidget mgr = (CompositeWidget) obj;
-
-      int i;
-      int original_gadget_count = self->gadgetChildCount;
-
-      self->gadgetChildCount = 0;
-      for (i = mgr->composite.num_children - 1; i >= 0; i--)
-      {
-	 Widget child = mgr->composite.children[ i ];
-
-	 if (child)
-	 {
-            if (!XtIsWidget( child ))
-            {
-               if (XtIsRectObj( child ))
-               {
-                  self->gadgetChildCount += 1;
-               }
-            }
-	 }	 
-      }
+      self->gadgetChildCount = _countGadgetChildren    ( obj );
+      self->helpGadgetCount  = _countHelpGadgetChildren( obj );
 
-      /*---------------------------------------------------------
-      -- If there are gadgets, install a pointer motion handler
-      ---------------------------------------------------------*/
-      if ((original_gadget_count==0) && (self->gadgetChildCount))
-      {
-         XtAddEventHandler( 
-	    obj, 
-	    PointerMotionMask,
-	    False,
-	    _motionInObjectEH,
-	    (XtPointer) self );
-      }
+      _selectGadgetMotion( self );
    }
    else if (!XtIsWidget( obj ))
    {
@@ -268,21 +400,7 @@ XscObject _XscObjectCreate( Widget obj )
       if (obj_parent)
       {
          obj_parent->gadgetChildCount += 1;
-
-
-         /*---------------------------------------------------------
-         -- Install a pointer motion handler when the first gadget
-         -- is located
-         ---------------------------------------------------------*/
-         if (obj_parent->gadgetChildCount == 1)
-         {
-            XtAddEventHandler( 
-	       parent, 
-	       PointerMotionMask,
-	       False,
-	       _motionInObjectEH,
-	       (XtPointer) obj_parent );
-         }
+         _XscObjectInvalidateGadgetIndex( parent );
       }
    }
    return self;
@@ -316,6 +434,65 @@ XscObject _XscObjectDeriveFromWidget( Widget obj )
 }
 
 
+/*------------------------------------------------------------------------------
+-- These functions are called when the events a widget selects may have 
+-- changed, or when a widget tree was realized.  A widget whose translations
+-- changed may now select all the events the dispatcher needs.  Any other
+-- change is only checked for dispatched widgets, since only they depend on
+-- it; it would be costly to take every other widget's handlers off.
+------------------------------------------------------------------------------*/
+void _XscObjectUpdateDispatch( Widget obj, Boolean translations )
+{
+   XscObject self;
+
+   if (!XtIsWidget( obj ))
+   {
+      return;
+   }
+
+   self = _XscObjectDeriveFromWidget( obj );
+   if (self && (self->dispatched || (translations && __centralDispatch)))
+   {
+      _selectDispatch( self );
+   }
+}
+
+void _XscObjectRealized( Widget obj )
+{
+   if (XtIsWidget( obj ) && XtIsRealized( obj ))
+   {
+      _dispatchRealized( obj );
+   }
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function is called when the geometry, managed set, or children of
+-- a widget may have changed.  It drops the gadget index of the widget and
+-- of its parent.
+------------------------------------------------------------------------------*/
+void _XscObjectInvalidateGadgetIndex( Widget obj )
+{
+   XscObject self   = _XscObjectDeriveFromWidget( obj );
+   Widget    parent = XtParent( obj );
+
+   if (self && self->gadgetIndex)
+   {
+      _XscGridInvalidate( self->gadgetIndex );
+   }
+
+   if (parent)
+   {
+      XscObject parent_obj = _XscObjectDeriveFromWidget( parent );
+
+      if (parent_obj && parent_obj->gadgetIndex)
+      {
+         _XscGridInvalidate( parent_obj->gadgetIndex );
+      }
+   }
+}
+
+
 void _XscObjectGadgetFocusIn ( XscObject self )
 {
     _enterObjectCue( self, NotifyAncestor );
@@ -332,16 +509,101 @@ void _XscObjectGadgetFocusOut( XscObject self )
 ==============================================================================*/
 
 
+/*------------------------------------------------------------------------------
+-- This function counts the gadgets managed by a composite
+------------------------------------------------------------------------------*/
+static Cardinal _countGadgetChildren( Widget obj )
+{
+   CompositeWidget mgr   = (CompositeWidget) obj;
+   Cardinal        count = 0;
+   int             i;
+
+   for (i = mgr->composite.num_children - 1; i >= 0; i--)
+   {
+      Widget child = mgr->composite.children[ i ];
+
+      if (child)
+      {
+         if (!XtIsWidget( child ))
+         {
+            if (XtIsRectObj( child ))
+            {
+               count += 1;
+            }
+         }
+      }	 
+   }
+   return count;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function counts the recorded gadgets of a composite that have a
+-- hint or tip
+------------------------------------------------------------------------------*/
+static Cardinal _countHelpGadgetChildren( Widget obj )
+{
+   CompositeWidget mgr   = (CompositeWidget) obj;
+   Cardinal        count = 0;
+   int             i;
+
+   for (i = mgr->composite.num_children - 1; i >= 0; i--)
+   {
+      Widget child = mgr->composite.children[ i ];
+
+      if (child && !XtIsWidget( child ) && XtIsRectObj( child ))
+      {
+         XscObject child_obj = _XscObjectDeriveFromWidget( child );
+
+         if (child_obj && child_obj->hasGadgetHelp)
+         {
+            count += 1;
+         }
+      }
+   }
+   return count;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function determines if an ancestor below the shell has a cue.  The
+-- cue is substituted when the object gets the focus, so the object needs
+-- a focus handler.
+------------------------------------------------------------------------------*/
+static Boolean _cueInScope( Widget obj )
+{
+   Widget parent;
+
+   for (parent = XtParent( obj ); parent; parent = XtParent( parent ))
+   {
+      XscObject parent_obj;
+
+      if (XtIsShell( parent )) break;
+
+      parent_obj = _XscObjectDeriveFromWidget( parent );
+      if (parent_obj && _XscObjectGetCue( parent_obj ))
+      {
+         return True;
+      }
+   }
+   return False;
+}
+
+
 /*------------------------------------------------------------------------------
 -- This callback is called to clean-up the structures associated with an
 -- object when its being destroyed
 ------------------------------------------------------------------------------*/
 static void _destroyObjectCB( Widget w, XtPointer cd, XtPointer cbd )
 {
-   XscObject self = _XscObjectDeriveFromWidget( w );
+   XscObject  self = _XscObjectDeriveFromWidget( w );
+   XscDisplay display;
+   Boolean    had_help = False;
    
    if (self)
    {
+      had_help = self->hasGadgetHelp;
+
       /*--------------------------------------
       -- If it has a tip structure delete it
       --------------------------------------*/
@@ -365,14 +627,27 @@ static void _destroyObjectCB( Widget w, XtPointer cd, XtPointer cbd )
       {
          _XscHintDestroy( self->hint );
       }
+
+      if (self->gadgetIndex)
+      {
+         _XscGridDestroy( self->gadgetIndex );
+      }
       
       /*--------------------------------------------------------------
       -- Remove the structure from the context manager and delete it
       --------------------------------------------------------------*/
       XDeleteContext( 
          XtDisplayOfObject( w ), (XID)self->object, _objectContextId );
-         
-      XtFree( (char*) self );
+
+      if (self->window != None)
+      {
+         XDeleteContext( XtDisplay( w ), self->window, _windowContextId );
+      }
+
+      display = self->display;
+      _XscScreenRemoveReference( self->screen );
+      _XscDisplayFreeRecord( display, XmXSC_POOL_OBJECT, (XtPointer) self );
+      _XscDisplayRemoveReference( display );
    }
    
    /*--------------------------------------------------------------------------
@@ -386,28 +661,145 @@ static void _destroyObjectCB( Widget w, XtPointer cd, XtPointer cbd )
       if (obj_parent)
       {
          /*------------------------------------------------------------
-         -- If this is the last gadget, then it is safe to remove the
-         -- pointer motion event handler
+         -- If this was the last gadget with help, then it is safe to
+         -- remove the pointer motion event handler
          ------------------------------------------------------------*/
-         if (obj_parent->gadgetChildCount == 1)
+         if (obj_parent->activeGadget == self)
+         {
+            obj_parent->activeGadget = NULL;
+         }
+
+         if (had_help)
          {
-            XtRemoveEventHandler( 
-	       w_parent, 
-	       PointerMotionMask,
-	       False,
-	       _motionInObjectEH,
-	       (XtPointer) obj_parent );
+            obj_parent->helpGadgetCount -= 1;
+            _selectGadgetMotion( obj_parent );
          }
          
          /*----------------------------------------
          -- Decrement the parent's gadget counter
          ----------------------------------------*/
          obj_parent->gadgetChildCount -= 1;
+         _XscObjectInvalidateGadgetIndex( w_parent );
       }
    }
 }
 
 
+/*------------------------------------------------------------------------------
+-- This function drops a record the sparse registry does not need.  Such a
+-- record has no cue, hint, or tip, and nothing was registered for it yet.
+------------------------------------------------------------------------------*/
+static void _discardObject( XscObject self )
+{
+   XscDisplay display = self->display;
+
+   assert( !self->cue && !self->hint && !self->tip );
+
+   _XscScreenRemoveReference( self->screen );
+   _XscDisplayFreeRecord( display, XmXSC_POOL_OBJECT, (XtPointer) self );
+   _XscDisplayRemoveReference( display );
+}
+
+
+/*------------------------------------------------------------------------------
+-- This is the central dispatcher for crossing and focus events.  Every 
+-- event is passed on to the replaced dispatcher first; if that delivered
+-- it, the record of the event's window gets the same treatment the
+-- per-widget event handlers would give it.
+------------------------------------------------------------------------------*/
+static Boolean _dispatchEvent( XEvent* event )
+{
+   Window    window = event->xany.window;
+   XscObject self   = NULL;
+   XPointer  data;
+   Boolean   handled;
+   Boolean   cont   = True;
+
+   if (!XFindContext( event->xany.display, window, _windowContextId, &data ))
+   {
+      self = (XscObject) data;
+
+      /*-----------------------------------------------------------
+      -- The widget may have been unrealized, and its window id
+      -- used again for another window
+      -----------------------------------------------------------*/
+      if (!XtIsRealized( self->object ) || 
+          (XtWindow( self->object ) != window))
+      {
+         XDeleteContext( event->xany.display, window, _windowContextId );
+         self->window = None;
+         self = NULL;
+      }
+   }
+
+   handled = _XscDisplayDispatchEvent( event );
+
+   if (handled && self)
+   {
+      if ((event->type == EnterNotify) || (event->type == LeaveNotify))
+      {
+         _enterOrLeaveObjectEH( self->object, (XtPointer) self, event, &cont );
+      }
+      else
+      {
+         _focusChangeEH( self->object, (XtPointer) self, event, &cont );
+      }
+   }
+   return handled;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function enters the windows of the dispatched records in a tree that
+-- was just realized
+------------------------------------------------------------------------------*/
+static void _dispatchRealized( Widget w )
+{
+   XscObject self = _XscObjectDeriveFromWidget( w );
+
+   if (self && self->dispatched)
+   {
+      _enterWindow( self );
+   }
+
+   if (XtIsComposite( w ))
+   {
+      CompositeWidget cw = (CompositeWidget) w;
+      Cardinal        i;
+
+      for (i = 0; i < cw->composite.num_children; i++)
+      {
+         if (XtIsWidget( cw->composite.children[ i ] ) &&
+             XtIsRealized( cw->composite.children[ i ] ))
+         {
+            _dispatchRealized( cw->composite.children[ i ] );
+         }
+      }
+   }
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function enters the window of a realized, dispatched record, so the
+-- dispatcher finds it with a single lookup
+------------------------------------------------------------------------------*/
+static void _enterWindow( XscObject self )
+{
+   Widget w = self->object;
+
+   if (self->window != XtWindow( w ))
+   {
+      if (self->window != None)
+      {
+         XDeleteContext( XtDisplay( w ), self->window, _windowContextId );
+      }
+      self->window = XtWindow( w );
+      XSaveContext( 
+         XtDisplay( w ), self->window, _windowContextId, (XPointer) self );
+   }
+}
+
+
 /*------------------------------------------------------------------------------
 -- This function specifies the actions to take when the pointer enters an
 -- object that has an associated hint
@@ -416,6 +808,8 @@ static void _enterObjectCue( XscObject self, int detail )
 {
    if (detail == NotifyAncestor)
    {
+      _loadObject( self );
+
       if (self->cue)
       {
          _XscCueActivate( self->cue );
@@ -428,7 +822,7 @@ static void _enterObjectCue( XscObject self, int detail )
          {
             XscObject parent_obj = _XscObjectDeriveFromWidget( parent );
             
-            if (parent_obj && parent_obj->cue)
+            if (parent_obj && _XscObjectGetCue( parent_obj ))
             {
                /*------------------------------------
                -- Thsi is a good Cue to use instead
@@ -453,10 +847,10 @@ static void _enterObjectCue( XscObject self, int detail )
 ------------------------------------------------------------------------------*/
 static void _enterObjectHint( XscObject self, int detail )
 {
-   XscDisplay display = _XscDisplayDeriveFromWidget( self->object );
+   XscDisplay display = self->display;
    XscObject  prev_hint_object;
-   
-   assert( display );
+
+   _loadObject( self );
 
    /*--------------------------------------------------------
    -- If the old hint object is still active, check if it is 
@@ -499,10 +893,10 @@ static void _enterObjectHint( XscObject self, int detail )
 ------------------------------------------------------------------------------*/
 static void _enterObjectTip( XscObject self, int detail )
 {
-   XscDisplay display = _XscDisplayDeriveFromWidget( self->object );
+   XscDisplay display = self->display;
    XscObject  prev_tip_object;
 
-   assert( display );
+   _loadObject( self );
    
    /*--------------------------------------------------------
    -- If the old tip object is still active, check if it is 
@@ -567,6 +961,12 @@ static void _enterOrLeaveObjectEH(
    
    assert( self );
 
+   _XscDisplayTrackPointer( 
+      self->display, 
+      event->xcrossing.root, event->xcrossing.x_root, event->xcrossing.y_root );
+
+   _XscDisplayExpireTipRestore( self->display, event->xcrossing.time );
+
    if (event->type == EnterNotify)
    {
       XCrossingEvent* enter_event = &(event->xcrossing);
@@ -582,13 +982,13 @@ static void _enterOrLeaveObjectEH(
       -- Don't bother looking for gadgets in non-manager widget and
       -- ignore gadgets if gadget_processing is false
       -------------------------------------------------------------*/
-      if (XtIsComposite( w ) && self->gadgetProcessing)
+      if (XtIsComposite( w ) && self->gadgetProcessing && 
+          self->helpGadgetCount)
       {
          /*------------------------------------------------
          -- See if there is a gadget at this x,y location
          ------------------------------------------------*/
-         Widget gadget = _XscHelpGetGadgetChild( 
-            w, enter_event->x, enter_event->y );
+         Widget gadget = _gadgetAt( self, enter_event->x, enter_event->y );
          
          if (gadget)
          {
@@ -608,6 +1008,9 @@ static void _enterOrLeaveObjectEH(
                   -- Record which of the object's gadgets is active
                   -------------------------------------------------*/
                   self->activeGadget = gadget_object;
+
+                  _XscDisplayIncrementCounter( 
+                     self->display, XmXSC_COUNTER_GADGET_TRANSITIONS );
                }
             }
          }
@@ -662,12 +1065,60 @@ static void _focusChangeEH(
 }
 
 
+/*------------------------------------------------------------------------------
+-- This function finds the gadget under the pointer.  Composites with many
+-- gadgets use a spatial index; it relies on the change hooks of X11R6 to
+-- learn about geometry changes, so X11R5 always scans.
+------------------------------------------------------------------------------*/
+static Widget _gadgetAt( XscObject self, int x, int y )
+{
+#if XtVersion >= 11006
+   if (self->gadgetChildCount >= XscHelpGridGadgetThreshold)
+   {
+      if (!self->gadgetIndex)
+      {
+         self->gadgetIndex = _XscGridCreate( self->object );
+      }
+      return _XscGridFindGadget( self->gadgetIndex, x, y );
+   }
+#endif
+   return _XscHelpGetGadgetChild( self->object, x, y );
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function computes the tip group id that a widget skipped by the
+-- sparse registry would have had.  Such a widget has the default group,
+-- so it shares the group of its parent unless the parent is a shell.
+------------------------------------------------------------------------------*/
+static int _implicitTipGroupId( Widget obj )
+{
+   for (;;)
+   {
+      Widget    parent = XtParent( obj );
+      XscObject parent_obj;
+
+      if (!parent || XtIsShell( parent ))
+      {
+         return - ((int) obj);
+      }
+
+      parent_obj = _XscObjectDeriveFromWidget( parent );
+      if (parent_obj)
+      {
+         return parent_obj->tipGroupId;
+      }
+      obj = parent;
+   }
+}
+
+
 /*------------------------------------------------------------------------------
 -- This function is called whenever the pointer moves off of a screen object.
 ------------------------------------------------------------------------------*/
 static void _leaveObject( XscObject self, Boolean drop_compound )
 {
-   XscDisplay display = _XscDisplayDeriveFromWidget( self->object );
+   XscDisplay display = self->display;
 
    /*-----------------------------
    -- If the object has a tip...
@@ -700,7 +1151,7 @@ static void _leaveObject( XscObject self, Boolean drop_compound )
          ----------------------------------------------------------*/
          if (!XscHintGetCompound( self->hint ) || drop_compound)
          {
-            XscShell shell =_XscShellDeriveFromWidget( self->object );
+            XscShell shell = _XscObjectGetShell( self );
 
             /*------------------------------------------------------------
             -- Set the timer to unmap the hint.  The hint could be
@@ -740,6 +1191,27 @@ static void _leaveObjectCue( XscObject self, int detail )
 }
 
 
+/*------------------------------------------------------------------------------
+-- This function loads the cue, hint, and tip of an object.  It does nothing
+-- if that has already been done.
+------------------------------------------------------------------------------*/
+static void _loadObject( XscObject self )
+{
+   if (!self->loaded)
+   {
+      self->loaded = True;
+
+      _XscResourceBegin( self->object );
+      _setupCue ( self, NULL );
+      _setupHint( self, NULL );
+      _setupTip ( self, NULL );
+      _XscResourceEnd( self->object );
+
+      _syncGadgetHelp( self );
+   }
+}
+
+
 /*------------------------------------------------------------------------------
 -- This event handler is called when the pointer is moved within a Composite
 -- widget that has one or more gadgets.  This function controls the gadget
@@ -753,9 +1225,20 @@ static void _motionInObjectEH(
 {
    Widget    gadget = NULL;
    XscObject self = (XscObject) cd;
+   XscObject previous;
+   int       x, y;
    
    assert( self );
 
+   if (event->type == MotionNotify)
+   {
+      _XscDisplayIncrementCounter( self->display, XmXSC_COUNTER_MOTION_EVENTS );
+
+      _XscDisplayTrackPointer( 
+         self->display, 
+         event->xmotion.root, event->xmotion.x_root, event->xmotion.y_root );
+   }
+
    /*----------------------------------------------------------
    -- If gadget processing is not desired, return immediately
    ----------------------------------------------------------*/
@@ -766,12 +1249,43 @@ static void _motionInObjectEH(
    
    if (event->type == MotionNotify)
    {
-      if (event->xmotion.subwindow != 0) return;
+      x = event->xmotion.x;
+      y = event->xmotion.y;
+
+      /*---------------------------------------------------------------
+      -- A hinted event stands for "the pointer moved".  The server
+      -- sends no more until the pointer is queried, which also tells
+      -- where it is now.
+      ---------------------------------------------------------------*/
+      if (event->xmotion.is_hint == NotifyHint)
+      {
+         Window       root, child;
+         int          root_x, root_y;
+         unsigned int mask;
+
+         _XscDisplayIncrementCounter( 
+            self->display, XmXSC_COUNTER_POINTER_QUERIES );
+
+         if (!XQueryPointer( 
+                XtDisplay( w ), XtWindow( w ), 
+                &root, &child, &root_x, &root_y, &x, &y, &mask ))
+         {
+            return;
+         }
+         _XscDisplayTrackPointer( self->display, root, root_x, root_y );
+
+         if (child != None) return;
+      }
+      else if (event->xmotion.subwindow != 0) 
+      {
+         return;
+      }
  
       /*--------------------------------------
       -- See if the pointer is over a gadget
       --------------------------------------*/
-      gadget = _XscHelpGetGadgetChild( w, event->xmotion.x, event->xmotion.y );
+      previous = self->activeGadget;
+      gadget   = _gadgetAt( self, x, y );
 
       /*-----------------------------------------
       -- If the pointer is over a gadget and...
@@ -811,6 +1325,13 @@ static void _motionInObjectEH(
                
                if (gadget_object)
                {
+                  /*----------------------------------------------------
+                  -- Entering a gadget is a crossing as well, so an old
+                  -- primed tip group restore must not apply to it
+                  ----------------------------------------------------*/
+                  _XscDisplayExpireTipRestore( 
+                     self->display, event->xmotion.time );
+
                   _enterObjectHint( gadget_object, NotifyAncestor );
                   _enterObjectTip ( gadget_object, NotifyAncestor );
                  self->activeGadget = gadget_object;
@@ -835,16 +1356,142 @@ static void _motionInObjectEH(
             _enterObjectTip ( self, NotifyAncestor );
          }
       }
+
+      if (self->activeGadget != previous)
+      {
+         _XscDisplayIncrementCounter( 
+            self->display, XmXSC_COUNTER_GADGET_TRANSITIONS );
+      }
    }
 }
 
 
+/*------------------------------------------------------------------------------
+-- This function decides if the sparse registry keeps an object's record.
+-- Gadgets always keep theirs; their parent does the event handling.
+------------------------------------------------------------------------------*/
+static Boolean _needsRecord( XscObject self, Boolean explicit_group )
+{
+   Widget obj = self->object;
+
+   if (!XtIsWidget( obj )) return True;
+
+   if (self->cue || self->hint || self->tip) return True;
+
+   if (explicit_group) return True;
+
+   if (XtIsComposite( obj ) && _countGadgetChildren( obj )) return True;
+
+   return _cueInScope( obj );
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function decides how a widget gets its crossing and focus events.
+-- The central dispatcher only sees events that Xt selects for the widget
+-- anyway (e.g., for its translations); widgets that do not ask for all of
+-- them get their own handlers.  Our own handlers are taken off before the
+-- event mask is built, so they do not count.  Adding them again when they
+-- are still there only merges their masks.
+------------------------------------------------------------------------------*/
+static void _selectDispatch( XscObject self )
+{
+   Widget  w      = self->object;
+   Mask    needed = EnterWindowMask | LeaveWindowMask | FocusChangeMask;
+   Boolean wanted = False;
+
+   if (__centralDispatch)
+   {
+      if (!self->dispatched)
+      {
+         XtRemoveEventHandler( 
+            w, EnterWindowMask | LeaveWindowMask, False,
+            _enterOrLeaveObjectEH, (XtPointer) self );
+         XtRemoveEventHandler( 
+            w, FocusChangeMask, False, _focusChangeEH, (XtPointer) self );
+      }
+      wanted = ((XtBuildEventMask( w ) & needed) == needed) &&
+         _XscDisplayInstallEventDispatcher( self->display, _dispatchEvent );
+   }
+
+   self->dispatched = wanted;
+
+   if (wanted)
+   {
+      if (XtIsRealized( w ))
+      {
+         _enterWindow( self );
+      }
+   }
+   else
+   {
+      if (self->window != None)
+      {
+         XDeleteContext( XtDisplay( w ), self->window, _windowContextId );
+         self->window = None;
+      }
+
+      XtAddEventHandler( 
+         w, 
+         EnterWindowMask | LeaveWindowMask,
+         False,
+         _enterOrLeaveObjectEH,
+         (XtPointer) self );
+
+      XtAddEventHandler( 
+         w, 
+         FocusChangeMask,
+         False,
+         _focusChangeEH,
+         (XtPointer) self );
+   }
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function installs or removes the pointer motion handler of a
+-- composite.  It is only needed while a gadget child has a hint or tip.
+------------------------------------------------------------------------------*/
+static void _selectGadgetMotion( XscObject self )
+{
+   Boolean   wanted = (self->helpGadgetCount > 0);
+   EventMask mask   = PointerMotionMask;
+
+   /*----------------------------------------------------------------
+   -- Hinted motion bounds the event rate, but it applies to every
+   -- motion event of the window, which is why it is an option
+   ----------------------------------------------------------------*/
+   if (self->motionHint)
+   {
+      mask |= PointerMotionHintMask;
+   }
+
+   if (wanted && !self->motionSelected)
+   {
+      XtAddEventHandler( 
+         self->object, mask, False, _motionInObjectEH, (XtPointer) self );
+   }
+   else if (!wanted && self->motionSelected)
+   {
+      XtRemoveEventHandler( 
+         self->object, mask, False, _motionInObjectEH, (XtPointer) self );
+
+      if (self->activeGadget)
+      {
+         _leaveObject( self->activeGadget, True );
+         self->activeGadget = NULL;
+      }
+   }
+   self->motionSelected = wanted;
+}
+
+
 /*------------------------------------------------------------------------------
 -- This function is used to retrieve tip attributes from the resource db
 ------------------------------------------------------------------------------*/
 static void _setupCue( XscObject self, const char* default_topic )
 {
-   XscText text = _XscTextCreate();
+   XscText text = _XscTextCreate( self->display );
    _XscTextLoadCueResources( text, self->object, default_topic );
    
    /*----------------------------------------------------------------
@@ -884,7 +1531,7 @@ static void _setupCue( XscObject self, const char* default_topic )
 ------------------------------------------------------------------------------*/
 static void _setupHint( XscObject self, const char* default_topic )
 {   
-   XscText text = _XscTextCreate();
+   XscText text = _XscTextCreate( self->display );
    _XscTextLoadHintResources( text, self->object, default_topic );
    
    /*----------------------------------------------------------------
@@ -921,11 +1568,13 @@ static void _setupHint( XscObject self, const char* default_topic )
 /*------------------------------------------------------------------------------
 -- This function is used to retrieve object attributes from the resource db
 ------------------------------------------------------------------------------*/
-static void _setupObject( XscObject self )
+static Boolean _setupObject( XscObject self, Boolean* explicit_group )
 {
    typedef struct _ObjectResources
    {
+      Boolean       gadget_motion_hint;
       Boolean       gadget_processing;
+      Boolean       lazy_load;
       int           tip_group_id;
       unsigned char tip_group_override;
       XFontStruct*  font;
@@ -944,10 +1593,18 @@ static void _setupObject( XscObject self )
          XmNxscFont, XmCXscFont,
          XtRFontStruct, sizeof( XFontStruct* ), OFFSET_OF( font ),
          XtRString, XscHelpDefaultFont
+      },{
+         XmNxscGadgetMotionHint, XmCXscGadgetMotionHint,
+         XmRBoolean, sizeof( Boolean ), OFFSET_OF( gadget_motion_hint ),
+         XtRImmediate, (XtPointer) (Boolean) False
       },{
          XmNxscGadgetProcessing, XmCXscGadgetProcessing,
          XmRBoolean, sizeof( Boolean ), OFFSET_OF( gadget_processing ),
          XtRImmediate, (XtPointer) (Boolean) True
+      },{
+         XmNxscLazyLoad, XmCXscLazyLoad,
+         XmRBoolean, sizeof( Boolean ), OFFSET_OF( lazy_load ),
+         XmRBoolean, (XtPointer) &__lazyLoad
       },{
          XmNxscTipGroupId, XmCXscTipGroupId,
          XmRXscTipGroupId, sizeof( int ), OFFSET_OF( tip_group_id ),
@@ -962,14 +1619,19 @@ static void _setupObject( XscObject self )
    
    memset( (char*) &object_resources, '\0', sizeof( ObjectResources ) );
    
-   XtGetApplicationResources( 
+   _XscResourceGetValues( 
       self->object, 
-      &object_resources, 
-      resource,      (Cardinal) XtNumber( resource ),
-      NULL,          (Cardinal) 0 );
+      (XtPointer) &object_resources, 
+      resource, (Cardinal) XtNumber( resource ) );
    
    self->gadgetProcessing = object_resources.gadget_processing;
+   self->motionHint       = object_resources.gadget_motion_hint;
    self->font             = object_resources.font;
+
+   *explicit_group = 
+      (object_resources.tip_group_id != XmXSC_TIP_GROUP_PARENT) ||
+      (object_resources.tip_group_override != 
+         (unsigned char) XmXSC_TIP_GROUP_NULL);
    
    /*---------------------------
    -- This block is deprecated
@@ -995,6 +1657,14 @@ static void _setupObject( XscObject self )
       {
       	 self->hasGroupLeader = _parentObj->hasGroupLeader;
       }
+      else if (!XtIsShell( _parent ))
+      {
+         /*-------------------------------------------------------------
+         -- The sparse registry skipped the parent.  It had the default
+         -- group, which always makes it a group leader.
+         -------------------------------------------------------------*/
+         self->hasGroupLeader = True;
+      }
    }
    
    
@@ -1033,6 +1703,10 @@ static void _setupObject( XscObject self )
          {
             self->tipGroupId = _parentObj->tipGroupId;
          }
+         else if (!XtIsShell( _parent ))
+         {
+            self->tipGroupId = _implicitTipGroupId( _parent );
+         }
          else
          {
             self->tipGroupId = - ((int) self->object);
@@ -1047,6 +1721,7 @@ static void _setupObject( XscObject self )
    {
       self->tipGroupId = - ((int) self->object);
    }
+   return object_resources.lazy_load;
 }
 
 
@@ -1055,7 +1730,7 @@ static void _setupObject( XscObject self )
 ------------------------------------------------------------------------------*/
 static void _setupTip( XscObject self, const char* default_topic )
 {
-   XscText text = _XscTextCreate();
+   XscText text = _XscTextCreate( self->display );
    _XscTextLoadTipResources( text, self->object, default_topic );
    
    /*----------------------------------------------------------------
@@ -1089,6 +1764,46 @@ static void _setupTip( XscObject self, const char* default_topic )
 }
 
 
+/*------------------------------------------------------------------------------
+-- This function keeps the parent's count of gadgets with a hint or tip
+-- current after the help of a gadget was (re)loaded or changed
+------------------------------------------------------------------------------*/
+static void _syncGadgetHelp( XscObject self )
+{
+   Widget    parent;
+   XscObject parent_obj;
+   Boolean   has_help;
+
+   if (XtIsWidget( self->object )) return;
+
+   has_help = (self->hint && XscHintHasValidTopic( self->hint )) ||
+              (self->tip  && XscTipHasValidTopic ( self->tip  ));
+
+   if (has_help == self->hasGadgetHelp) return;
+
+   self->hasGadgetHelp = has_help;
+
+   /*------------------------------------------------------------------
+   -- A parent without a record counts its gadgets when it is created
+   ------------------------------------------------------------------*/
+   parent     = XtParent( self->object );
+   parent_obj = parent ? _XscObjectDeriveFromWidget( parent ) : NULL;
+
+   if (parent_obj)
+   {
+      if (has_help)
+      {
+         parent_obj->helpGadgetCount += 1;
+      }
+      else
+      {
+         parent_obj->helpGadgetCount -= 1;
+      }
+      _selectGadgetMotion( parent_obj );
+   }
+}
+
+
 /*-----------------------------------------------
 -- This function updates the display of a Tip
 -----------------------------------------------*/
@@ -1100,14 +1815,8 @@ static void _updateCue( XscObject self, XscDisplay display )
       {
          if (XscCueHasValidTopic( self->cue ))
          {
-            XscScreen screen;
-
             _XscCueUpdate( self->cue );
-
-            screen = _XscScreenDeriveFromWidget( self->object );
-            assert( screen );
-
-            _XscScreenRedrawCue( screen );
+            _XscScreenRedrawCue( self->screen );
          }
       }
    }
@@ -1123,7 +1832,7 @@ static void _updateHint( XscObject self, XscDisplay display )
    {
       if (_XscObjectHasValidHint( self ))
       {
-         XscShell shell = _XscShellDeriveFromWidget( self->object );
+         XscShell shell = _XscObjectGetShell( self );
          
          if (shell) _XscShellUpdateHint( shell );
       }
@@ -1139,14 +1848,8 @@ static void _updateTip( XscObject self, XscDisplay display )
    {
       if (_XscObjectHasValidTip( self ))
       {
-         XscScreen screen;
-
          _XscTipUpdate( self->tip );
-
-         screen = _XscScreenDeriveFromWidget( self->object );
-         assert( screen );
-
-         _XscScreenRedrawTip( screen );
+         _XscScreenRedrawTip( self->screen );
       }
    }
 }
@@ -1185,10 +1888,12 @@ void XscHelpSetGadgetProcessing( Widget w, Boolean a )
 
 void XscHelpSetCueTopic( Widget w, String a )
 {
-   XscObject object = _XscObjectDeriveFromWidget( w );
+   XscObject object = _XscObjectPromote( w );
    
    if (object)
    {
+      _loadObject( object );
+
       if (!object->cue)
       {
          _setupCue( object, a );
@@ -1205,12 +1910,14 @@ void XscHelpSetCueTopicDetails(
    Widget w, String s, XmFontList fl, String flt, 
    unsigned char a, unsigned char d, unsigned char c )
 {
-   XscObject object = _XscObjectDeriveFromWidget( w );
+   XscObject object = _XscObjectPromote( w );
    
    if (object)
    {
       XscText text;
       
+      _loadObject( object );
+
       if (!object->cue)
       {
          _setupCue( object, s );
@@ -1227,17 +1934,19 @@ void XscHelpSetCueTopicDetails(
       _XscTextSetDirection  ( text, d   );
       _XscTextSetConverter  ( text, c   );
 
-      _XscTextCreateCompoundString( text, object->object );
+      _XscTextMarkDirty( text, object->object );
    }
 }
 
 
 void XscHelpSetHintTopic( Widget w, String a )
 {
-   XscObject object = _XscObjectDeriveFromWidget( w );
+   XscObject object = _XscObjectPromote( w );
    
    if (object)
    {
+      _loadObject( object );
+
       if (!object->hint)
       {
          _setupHint( object, a );
@@ -1246,6 +1955,7 @@ void XscHelpSetHintTopic( Widget w, String a )
       {
          XscHintSetTopic( object->hint, a );
       }
+      _syncGadgetHelp( object );
    }
 }
 
@@ -1254,12 +1964,14 @@ void XscHelpSetHintTopicDetails(
    Widget w, String s, XmFontList fl, String flt, 
    unsigned char a, unsigned char d, unsigned char c )
 {
-   XscObject object = _XscObjectDeriveFromWidget( w );
+   XscObject object = _XscObjectPromote( w );
    
    if (object)
    {
       XscText text;
       
+      _loadObject( object );
+
       if (!object->hint)
       {
          _setupHint( object, s );
@@ -1276,17 +1988,20 @@ void XscHelpSetHintTopicDetails(
       _XscTextSetDirection  ( text, d   );
       _XscTextSetConverter  ( text, c   );
 
-      _XscTextCreateCompoundString( text, object->object );
+      _XscTextMarkDirty( text, object->object );
+      _syncGadgetHelp( object );
    }
 }
 
 
 void XscHelpSetTipTopic( Widget w, String a )
 {
-   XscObject object = _XscObjectDeriveFromWidget( w );
+   XscObject object = _XscObjectPromote( w );
    
    if (object)
    {
+      _loadObject( object );
+
       if (!object->tip)
       {
          _setupTip( object, a );
@@ -1295,6 +2010,7 @@ void XscHelpSetTipTopic( Widget w, String a )
       {
          XscTipSetTopic( object->tip, a );
       }
+      _syncGadgetHelp( object );
    }
 }
 
@@ -1303,12 +2019,14 @@ void XscHelpSetTipTopicDetails(
    Widget w, String s, XmFontList fl, String flt, 
    unsigned char a, unsigned char d, unsigned char c )
 {
-   XscObject object = _XscObjectDeriveFromWidget( w );
+   XscObject object = _XscObjectPromote( w );
    
    if (object)
    {
       XscText text;
       
+      _loadObject( object );
+
       if (!object->tip)
       {
          _setupTip( object, s );
@@ -1325,7 +2043,8 @@ void XscHelpSetTipTopicDetails(
       _XscTextSetDirection  ( text, d   );
       _XscTextSetConverter  ( text, c   );
 
-      _XscTextCreateCompoundString( text, object->object );
+      _XscTextMarkDirty( text, object->object );
+      _syncGadgetHelp( object );
    }
 }
 
@@ -1353,9 +2072,15 @@ void XscHelpDbReload( Widget obj )
    ----------------------------------------------------------*/
    if (object)
    {
+      object->loaded = True;
+
+      _XscResourceBegin( obj );
       _setupCue ( object, NULL );
       _setupTip ( object, NULL );
       _setupHint( object, NULL );
+      _XscResourceEnd( obj );
+
+      _syncGadgetHelp( object );
    }
    else
    {
@@ -1391,7 +2116,7 @@ void XscHelpUpdate( Widget obj )
    
    if (object)
    {
-      XscDisplay display = _XscDisplayDeriveFromWidget( obj );
+      XscDisplay display = object->display;
       _updateTip ( object, display );
       _updateCue ( object, display );
       _updateHint( object, display );
@@ -1407,7 +2132,7 @@ void XscHelpCueUpdate( Widget obj )
    
    if (object)
    {
-      _updateCue( object, _XscDisplayDeriveFromWidget( obj ) );
+      _updateCue( object, object->display );
    }
 }
 
@@ -1421,7 +2146,7 @@ void XscHelpHintUpdate( Widget obj )
    
    if (object)
    {
-      _updateHint( object, _XscDisplayDeriveFromWidget( obj ) );
+      _updateHint( object, object->display );
    }
 }
 
@@ -1434,7 +2159,7 @@ void XscHelpTipUpdate( Widget obj )
    
    if (object)
    {
-      _updateTip( object, _XscDisplayDeriveFromWidget( obj ) );
+      _updateTip( object, object->display );
    }
 }
 
@@ -29,6 +29,10 @@ typedef struct _XscObjectRec *XscObject;
 #include <Xsc/Hint.h>
 #include <Xsc/Tip.h>
 
+#include "DisplayP.h"
+#include "ScreenP.h"
+#include "ShellP.h"
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,11 +59,20 @@ void _XscObjectInitialize( XContext );
 
 XscObject _XscObjectCreate( Widget );
 XscObject _XscObjectDeriveFromWidget( Widget );
+XscObject _XscObjectPromote( Widget );
+
+void _XscObjectInvalidateGadgetIndex( Widget );
+void _XscObjectRealized              ( Widget );
+void _XscObjectUpdateDispatch        ( Widget, Boolean );
 
 void _XscObjectGadgetFocusIn ( XscObject );
 void _XscObjectGadgetFocusOut( XscObject );
 
-XscCue  _XscObjectGetCue       ( XscObject );
+XscCue     _XscObjectGetCue    ( XscObject );
+XscDisplay _XscObjectGetDisplay( XscObject );
+XscScreen  _XscObjectGetScreen ( XscObject );
+XscShell   _XscObjectGetShell  ( XscObject );
+
 Font    _XscObjectGetFont      ( XscObject );
 XscHint _XscObjectGetHint      ( XscObject );
 XscTip  _XscObjectGetTip       ( XscObject );
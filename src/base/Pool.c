@@ -0,0 +1,210 @@
+/*------------------------------------------------------------------------------
+--  Help ToolKit for Motif
+--
+--  (c) Copyright 1997-1999, 2019 Robert S. Werner (a.k.a. Akiva Werner)
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+------------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <X11/Intrinsic.h>
+
+#include <Xsc/Help.h>
+
+#include "PoolP.h"
+
+/*==============================================================================
+                               Private data types
+==============================================================================*/
+/*------------------------------------------------------------------------
+-- A slab is a single allocation holding a fixed number of records.  The
+-- records immediately follow the slab header.  The union makes sure the
+-- first record is aligned for any of the record types we store.
+------------------------------------------------------------------------*/
+typedef struct _XscPoolSlabRec
+{
+   struct _XscPoolSlabRec* next;
+   union
+   {
+      double    d;
+      long      l;
+      XtPointer p;
+   }
+   align;
+}
+XscPoolSlabRec;
+
+/*------------------------------------------------------------------------
+-- Free records are chained through their first word
+------------------------------------------------------------------------*/
+typedef struct _XscPoolFreeRec
+{
+   struct _XscPoolFreeRec* next;
+}
+XscPoolFreeRec;
+
+typedef struct _XscPoolRec
+{
+   Cardinal        recordSize;      /* Rounded up for alignment */
+   Cardinal        recordsPerSlab;
+   XscPoolSlabRec* slabs;
+   XscPoolFreeRec* freeList;
+   Cardinal        slabCount;
+   Cardinal        recordsInUse;
+   Cardinal        highWaterMark;
+}
+XscPoolRec;
+
+
+/*==============================================================================
+                               Private prototypes
+==============================================================================*/
+static void _addSlab( XscPool );
+
+
+/*==============================================================================
+                               Protected functions
+==============================================================================*/
+
+/*----------------------------------------------------------------------------
+-- This function is used to create a pool of fixed size records
+------------------------------------------------------------------------------*/
+XscPool _XscPoolCreate( Cardinal record_size, Cardinal records_per_slab )
+{
+   XscPool  self  = XtNew( XscPoolRec );
+   Cardinal align = sizeof( ((XscPoolSlabRec*) NULL)->align );
+
+   if (record_size < sizeof( XscPoolFreeRec ))
+   {
+      record_size = sizeof( XscPoolFreeRec );
+   }
+   if (records_per_slab == 0)
+   {
+      records_per_slab = XscHelpDefaultPoolRecordsPerSlab;
+   }
+
+   self->recordSize     = ((record_size + align - 1) / align) * align;
+   self->recordsPerSlab = records_per_slab;
+   self->slabs          = NULL;
+   self->freeList       = NULL;
+   self->slabCount      = 0;
+   self->recordsInUse   = 0;
+   self->highWaterMark  = 0;
+
+   return self;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function releases the pool and all of its slabs.  Any record still
+-- allocated from the pool is released along with it.
+------------------------------------------------------------------------------*/
+void _XscPoolDestroy( XscPool self )
+{
+   XscPoolSlabRec* slab = self->slabs;
+
+   while (slab)
+   {
+      XscPoolSlabRec* next = slab->next;
+      XtFree( (char*) slab );
+      slab = next;
+   }
+   XtFree( (char*) self );
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function returns a zero filled record from the pool
+------------------------------------------------------------------------------*/
+XtPointer _XscPoolAlloc( XscPool self )
+{
+   XscPoolFreeRec* record;
+
+   if (self->freeList == NULL)
+   {
+      _addSlab( self );
+   }
+
+   record = self->freeList;
+   self->freeList = record->next;
+
+   self->recordsInUse += 1;
+   if (self->recordsInUse > self->highWaterMark)
+   {
+      self->highWaterMark = self->recordsInUse;
+   }
+
+   memset( (char*) record, '\0', self->recordSize );
+
+   return (XtPointer) record;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function returns a record to the pool's free list for reuse
+------------------------------------------------------------------------------*/
+void _XscPoolFree( XscPool self, XtPointer data )
+{
+   XscPoolFreeRec* record = (XscPoolFreeRec*) data;
+
+   assert( self->recordsInUse > 0 );
+
+   record->next   = self->freeList;
+   self->freeList = record;
+
+   self->recordsInUse -= 1;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function reports how much memory the pool is holding on to
+------------------------------------------------------------------------------*/
+void _XscPoolGetStatistics( XscPool self, XscHelpPoolStatistics* stats )
+{
+   stats->slabsInUse    = self->slabCount;
+   stats->bytesReserved = self->slabCount *
+      (sizeof( XscPoolSlabRec ) + self->recordSize * self->recordsPerSlab);
+   stats->recordsInUse  = self->recordsInUse;
+   stats->highWaterMark = self->highWaterMark;
+}
+
+
+
+/*==============================================================================
+                               Private functions
+==============================================================================*/
+
+/*----------------------------------------------------------------------------
+-- This function allocates a new slab and threads its records onto the
+-- free list
+------------------------------------------------------------------------------*/
+static void _addSlab( XscPool self )
+{
+   XscPoolSlabRec* slab;
+   char*           base;
+   Cardinal        i;
+
+   slab = (XscPoolSlabRec*) XtMalloc(
+      sizeof( XscPoolSlabRec ) + self->recordSize * self->recordsPerSlab );
+
+   slab->next  = self->slabs;
+   self->slabs = slab;
+   self->slabCount += 1;
+
+   /*----------------------------------------------------------------
+   -- Thread the records backwards so they are handed out in order
+   ----------------------------------------------------------------*/
+   base = (char*) (slab + 1);
+   for (i = self->recordsPerSlab; i > 0; i--)
+   {
+      XscPoolFreeRec* record =
+         (XscPoolFreeRec*) (base + (i - 1) * self->recordSize);
+
+      record->next   = self->freeList;
+      self->freeList = record;
+   }
+}
@@ -0,0 +1,61 @@
+/*------------------------------------------------------------------------------
+--  Help ToolKit for Motif
+--
+--  (c) Copyright 1997-1999, 2019 Robert S. Werner (a.k.a. Akiva Werner)
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+------------------------------------------------------------------------------*/
+
+#ifndef __XscPoolP_h
+#define __XscPoolP_h
+
+
+#include <X11/Intrinsic.h>
+#include <Xm/Xm.h>
+
+#include <Xsc/Help.h>
+
+/*==============================================================================
+                                   Handle
+==============================================================================*/
+typedef struct _XscPoolRec *XscPool;
+
+
+/*==============================================================================
+                              Private Includes
+==============================================================================*/
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+                                    Macros
+==============================================================================*/
+#define XscHelpDefaultPoolRecordsPerSlab 32
+
+
+/*==============================================================================
+                               Data types
+==============================================================================*/
+
+
+/*==============================================================================
+                                  Prototypes
+==============================================================================*/
+XscPool _XscPoolCreate ( Cardinal, Cardinal );
+void    _XscPoolDestroy( XscPool );
+
+XtPointer _XscPoolAlloc( XscPool );
+void      _XscPoolFree ( XscPool, XtPointer );
+
+void _XscPoolGetStatistics( XscPool, XscHelpPoolStatistics* );
+
+
+#ifdef __cplusplus
+}  /* Close scope of 'extern "C"' declaration which encloses file. */
+#endif
+
+#endif
@@ -0,0 +1,524 @@
+/*------------------------------------------------------------------------------
+--  Help ToolKit for Motif
+--
+--  (c) Copyright 1997-1999, 2019 Robert S. Werner (a.k.a. Akiva Werner)
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+------------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <X11/IntrinsicP.h>
+#include <X11/ShellP.h>
+
+#include <Xsc/Help.h>
+
+#include "ResourceP.h"
+
+/*==============================================================================
+                               Private data types
+==============================================================================*/
+/*-------------------------------------------------------------------------
+-- Each static resource table is compiled into quarks the first time it
+-- is used.  The quarks are stored four per resource: name, class, type,
+-- and default type.
+-------------------------------------------------------------------------*/
+typedef struct _XscResourceTableRec
+{
+   struct _XscResourceTableRec* next;
+   XtResource*                  resource;
+   Cardinal                     count;
+   XrmQuark*                    quarks;
+}
+XscResourceTableRec, *XscResourceTable;
+
+/*-------------------------------------------------------------------------
+-- Xrm search list and the buffer size it was built in
+-------------------------------------------------------------------------*/
+typedef struct
+{
+   XrmHashTable* list;
+   int           size;
+}
+XscResourceSearchRec;
+
+
+/*==============================================================================
+                               Private prototypes
+==============================================================================*/
+static XscResourceTable _compileTable( XtResource*, Cardinal );
+
+static void    _copyFromArg   ( XtArgVal, char*, Cardinal );
+static void    _copyValue     ( XrmQuark, XrmValue*, char*, Cardinal );
+static Boolean _convertValue  ( Widget, String, XrmValue*, XtResource*, char* );
+static XrmDatabase _databaseOf( Widget );
+static void    _forgetParentCB( Widget, XtPointer, XtPointer );
+static void    _growPath      ( Cardinal );
+static void    _loadDefault   ( Widget, XtResource*, XrmQuark*, char* );
+static void    _loadSearchList( Widget, XrmDatabase, XscResourceSearchRec* );
+static void    _pathOf        ( Widget );
+static void    _storePath     ( Widget, Cardinal );
+
+
+/*==============================================================================
+                           Static global variables
+==============================================================================*/
+/*-----------------------------------------------------
+-- Resource tables that have been compiled to quarks
+-----------------------------------------------------*/
+static XscResourceTable _tables = NULL;
+
+/*---------------------------------------------------------------------------
+-- The name/class path of the most recent parent.  Siblings are normally
+-- created and loaded one after another, so the parent's part of the path
+-- only has to be walked once.
+---------------------------------------------------------------------------*/
+static Widget    _pathParent       = NULL;
+static Cardinal  _pathParentLength = 0;
+static XrmName*  _pathNames        = NULL;
+static XrmClass* _pathClasses      = NULL;
+static Cardinal  _pathSize         = 0;
+
+/*---------------------------------------------------------------------------
+-- While a widget's help is being loaded, its search list is built once
+-- and shared by every resource fetch for that widget.
+---------------------------------------------------------------------------*/
+static Widget               _scopeWidget = NULL;
+static Cardinal             _scopeDepth  = 0;
+static XrmDatabase          _scopeDb     = NULL;
+static XscResourceSearchRec _scopeSearch = { NULL, 0 };
+static XscResourceSearchRec _tempSearch  = { NULL, 0 };
+
+static XrmQuark _QCallProc  = NULLQUARK;
+static XrmQuark _QImmediate = NULLQUARK;
+static XrmQuark _QString    = NULLQUARK;
+
+
+
+/*==============================================================================
+                               Protected functions
+==============================================================================*/
+
+/*----------------------------------------------------------------------------
+-- These functions bracket the loading of one widget's help resources.
+-- Every _XscResourceGetValues() call for the widget in between shares a
+-- single search list.  The resource database must not change in between.
+------------------------------------------------------------------------------*/
+void _XscResourceBegin( Widget w )
+{
+   if (_scopeDepth == 0)
+   {
+      _scopeWidget = w;
+      _scopeDb     = _databaseOf( w );
+      _loadSearchList( w, _scopeDb, &_scopeSearch );
+   }
+   _scopeDepth += 1;
+}
+
+void _XscResourceEnd( Widget w )
+{
+   assert( _scopeDepth > 0 );
+
+   _scopeDepth -= 1;
+   if (_scopeDepth == 0)
+   {
+      _scopeWidget = NULL;
+      _scopeDb     = NULL;
+   }
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function is a replacement for XtGetApplicationResources() without
+-- an argument list.  It follows the same lookup, conversion and default
+-- rules, but keeps the compiled resource tables and search lists around.
+------------------------------------------------------------------------------*/
+void _XscResourceGetValues(
+   Widget      w,
+   XtPointer   base,
+   XtResource* resource,
+   Cardinal    count )
+{
+   XscResourceTable table = _compileTable( resource, count );
+   XrmDatabase      db    = _databaseOf( w );
+   XrmHashTable*    list;
+   Cardinal         i;
+
+   if (_scopeDepth && (_scopeWidget == w) && (_scopeDb == db))
+   {
+      list = _scopeSearch.list;
+   }
+   else
+   {
+      _loadSearchList( w, db, &_tempSearch );
+      list = _tempSearch.list;
+   }
+
+   for (i = 0; i < count; i++)
+   {
+      XtResource*       res    = &resource[ i ];
+      XrmQuark*         quarks = &table->quarks[ i * 4 ];
+      char*             dst    = (char*) base + res->resource_offset;
+      XrmRepresentation type;
+      XrmValue          value;
+      Boolean           found  = False;
+
+      if (XrmQGetSearchResource( list, quarks[0], quarks[1], &type, &value ))
+      {
+         if (type == quarks[2])
+         {
+            _copyValue( type, &value, dst, res->resource_size );
+            found = True;
+         }
+         else
+         {
+            found = _convertValue(
+               w, XrmQuarkToString( type ), &value, res, dst );
+         }
+      }
+
+      if (!found)
+      {
+         _loadDefault( w, res, quarks, dst );
+      }
+   }
+}
+
+
+
+/*==============================================================================
+                               Private functions
+==============================================================================*/
+
+/*----------------------------------------------------------------------------
+-- This function returns the compiled form of a resource table
+------------------------------------------------------------------------------*/
+static XscResourceTable _compileTable( XtResource* resource, Cardinal count )
+{
+   XscResourceTable table;
+   Cardinal         i;
+
+   for (table = _tables; table; table = table->next)
+   {
+      if ((table->resource == resource) && (table->count == count))
+      {
+         return table;
+      }
+   }
+
+   if (_QString == NULLQUARK)
+   {
+      _QCallProc  = XrmPermStringToQuark( XtRCallProc  );
+      _QImmediate = XrmPermStringToQuark( XtRImmediate );
+      _QString    = XrmPermStringToQuark( XtRString    );
+   }
+
+   table = XtNew( XscResourceTableRec );
+   table->resource = resource;
+   table->count    = count;
+   table->quarks   = (XrmQuark*) XtMalloc( sizeof( XrmQuark ) * 4 * count );
+
+   for (i = 0; i < count; i++)
+   {
+      table->quarks[ i*4 + 0 ] = XrmPermStringToQuark(resource[i].resource_name);
+      table->quarks[ i*4 + 1 ] = XrmPermStringToQuark(resource[i].resource_class);
+      table->quarks[ i*4 + 2 ] = XrmPermStringToQuark(resource[i].resource_type);
+      table->quarks[ i*4 + 3 ] = XrmPermStringToQuark(resource[i].default_type);
+   }
+
+   table->next = _tables;
+   _tables     = table;
+
+   return table;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function stores an immediate value the way Xt does
+------------------------------------------------------------------------------*/
+static void _copyFromArg( XtArgVal src, char* dst, Cardinal size )
+{
+   if (size > sizeof( XtArgVal ))
+   {
+      memcpy( dst, (char*) src, size );
+   }
+   else if (size == sizeof( long ))
+   {
+      *(long*) dst = (long) src;
+   }
+   else if (size == sizeof( int ))
+   {
+      *(int*) dst = (int) src;
+   }
+   else if (size == sizeof( short ))
+   {
+      *(short*) dst = (short) src;
+   }
+   else if (size == sizeof( char ))
+   {
+      *(char*) dst = (char) src;
+   }
+   else
+   {
+      memcpy( dst, (char*) &src, size );
+   }
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function stores a value that already has the resource's type.
+-- Strings are stored by reference, just as Xt does.
+------------------------------------------------------------------------------*/
+static void _copyValue(
+   XrmQuark  type,
+   XrmValue* value,
+   char*     dst,
+   Cardinal  size )
+{
+   if (type == _QString)
+   {
+      *(String*) dst = (String) value->addr;
+   }
+   else if (value->addr)
+   {
+      memcpy( dst, (char*) value->addr, size );
+   }
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function converts a value into the resource's type
+------------------------------------------------------------------------------*/
+static Boolean _convertValue(
+   Widget      w,
+   String      from_type,
+   XrmValue*   from,
+   XtResource* res,
+   char*       dst )
+{
+   XrmValue to;
+
+   to.addr = (XPointer) dst;
+   to.size = res->resource_size;
+
+   return XtConvertAndStore( w, from_type, from, res->resource_type, &to );
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function returns the database Xt would use for the widget
+------------------------------------------------------------------------------*/
+static XrmDatabase _databaseOf( Widget w )
+{
+#if XtVersion >= 11006
+   return XtScreenDatabase( XtScreenOfObject( w ) );
+#else
+   return XtDatabase( XtDisplayOfObject( w ) );
+#endif
+}
+
+
+/*----------------------------------------------------------------------------
+-- This callback drops the cached path when the cached parent goes away
+------------------------------------------------------------------------------*/
+static void _forgetParentCB( Widget w, XtPointer cd, XtPointer cbd )
+{
+   if (w == _pathParent)
+   {
+      _pathParent       = NULL;
+      _pathParentLength = 0;
+   }
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function makes room for a path of the given length plus the
+-- terminating NULLQUARK
+------------------------------------------------------------------------------*/
+static void _growPath( Cardinal length )
+{
+   if (length + 1 > _pathSize)
+   {
+      _pathSize    = length + 16;
+      _pathNames   = (XrmName*)  XtRealloc(
+         (char*) _pathNames,   sizeof( XrmName  ) * _pathSize );
+      _pathClasses = (XrmClass*) XtRealloc(
+         (char*) _pathClasses, sizeof( XrmClass ) * _pathSize );
+   }
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function applies the resource's default value
+------------------------------------------------------------------------------*/
+static void _loadDefault(
+   Widget      w,
+   XtResource* res,
+   XrmQuark*   quarks,
+   char*       dst )
+{
+   XrmQuark type         = quarks[2];
+   XrmQuark default_type = quarks[3];
+
+   if (default_type == _QCallProc)
+   {
+      XrmValue value;
+
+      value.addr = NULL;
+      value.size = 0;
+      (*(XtResourceDefaultProc) res->default_addr)(
+         w, res->resource_offset, &value );
+
+      _copyValue( type, &value, dst, res->resource_size );
+   }
+   else if (default_type == _QImmediate)
+   {
+      if (type == _QString)
+      {
+         *(String*) dst = (String) res->default_addr;
+      }
+      else
+      {
+         _copyFromArg( (XtArgVal) res->default_addr, dst, res->resource_size );
+      }
+   }
+   else if (default_type == type)
+   {
+      if (type == _QString)
+      {
+         *(String*) dst = (String) res->default_addr;
+      }
+      else if (res->default_addr)
+      {
+         memcpy( dst, (char*) res->default_addr, res->resource_size );
+      }
+   }
+   else if (res->default_addr)
+   {
+      XrmValue value;
+
+      value.addr = (XPointer) res->default_addr;
+      if (default_type == _QString)
+      {
+         value.size = strlen( (char*) res->default_addr ) + 1;
+      }
+      else
+      {
+         value.size = sizeof( XtPointer );
+      }
+      _convertValue( w, res->default_type, &value, res, dst );
+   }
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function builds the widget's search list, growing the buffer until
+-- the whole list fits
+------------------------------------------------------------------------------*/
+static void _loadSearchList(
+   Widget                w,
+   XrmDatabase           db,
+   XscResourceSearchRec* search )
+{
+   _pathOf( w );
+
+   if (search->list == NULL)
+   {
+      search->size = 64;
+      search->list = (XrmHashTable*) XtMalloc(
+         sizeof( XrmHashTable ) * search->size );
+   }
+
+   while (!XrmQGetSearchList(
+      db, _pathNames, _pathClasses, search->list, search->size ))
+   {
+      search->size *= 2;
+      search->list  = (XrmHashTable*) XtRealloc(
+         (char*) search->list, sizeof( XrmHashTable ) * search->size );
+   }
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function fills the path buffers with the widget's name/class path.
+-- The parent's part is reused when the parent has not changed.
+------------------------------------------------------------------------------*/
+static void _pathOf( Widget w )
+{
+   Widget   parent = XtParent( w );
+   Cardinal length;
+
+   if (parent == NULL)
+   {
+      /*-------------------------------------------------
+      -- The root overwrites the cached parent's path
+      -------------------------------------------------*/
+      if (_pathParent)
+      {
+         XtRemoveCallback(
+            _pathParent, XtNdestroyCallback, _forgetParentCB, NULL );
+         _pathParent       = NULL;
+         _pathParentLength = 0;
+      }
+      _storePath( w, 0 );
+      _pathNames  [ 1 ] = NULLQUARK;
+      _pathClasses[ 1 ] = NULLQUARK;
+      return;
+   }
+
+   if (parent != _pathParent)
+   {
+      Widget   p;
+      Cardinal depth = 0;
+
+      for (p = parent; p; p = XtParent( p ))
+      {
+         depth += 1;
+      }
+      _growPath( depth + 1 );
+
+      for (p = parent, length = depth; p; p = XtParent( p ))
+      {
+         _storePath( p, --length );
+      }
+
+      if (_pathParent)
+      {
+         XtRemoveCallback(
+            _pathParent, XtNdestroyCallback, _forgetParentCB, NULL );
+      }
+      XtAddCallback( parent, XtNdestroyCallback, _forgetParentCB, NULL );
+
+      _pathParent       = parent;
+      _pathParentLength = depth;
+   }
+
+   length = _pathParentLength;
+   _storePath( w, length );
+
+   _pathNames  [ length + 1 ] = NULLQUARK;
+   _pathClasses[ length + 1 ] = NULLQUARK;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function stores one widget in the path buffers, leaving room for
+-- the terminator.  As in Xt, a root that is an application shell uses its
+-- application class; any other root uses its widget class.
+------------------------------------------------------------------------------*/
+static void _storePath( Widget w, Cardinal index )
+{
+   _growPath( index + 1 );
+
+   _pathNames  [ index ] = w->core.xrm_name;
+   _pathClasses[ index ] = XtClass( w )->core_class.xrm_class;
+
+   if ((XtParent( w ) == NULL) && XtIsApplicationShell( w ))
+   {
+      _pathClasses[ index ] =
+         ((ApplicationShellWidget) w)->application.xrm_class;
+   }
+}
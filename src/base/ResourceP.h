@@ -0,0 +1,55 @@
+/*------------------------------------------------------------------------------
+--  Help ToolKit for Motif
+--
+--  (c) Copyright 1997-1999, 2019 Robert S. Werner (a.k.a. Akiva Werner)
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+------------------------------------------------------------------------------*/
+
+#ifndef __XscResourceP_h
+#define __XscResourceP_h
+
+
+#include <X11/Intrinsic.h>
+#include <Xm/Xm.h>
+
+
+/*==============================================================================
+                                   Handle
+==============================================================================*/
+
+
+/*==============================================================================
+                              Private Includes
+==============================================================================*/
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+                                    Macros
+==============================================================================*/
+
+
+/*==============================================================================
+                               Data types
+==============================================================================*/
+
+
+/*==============================================================================
+                                  Prototypes
+==============================================================================*/
+void _XscResourceBegin( Widget );
+void _XscResourceEnd  ( Widget );
+
+void _XscResourceGetValues( Widget, XtPointer, XtResource*, Cardinal );
+
+
+#ifdef __cplusplus
+}  /* Close scope of 'extern "C"' declaration which encloses file. */
+#endif
+
+#endif
@@ -11,13 +11,15 @@
 #include <stdio.h>
 #include <string.h>
 
-#include <X11/Intrinsic.h>
+#include <X11/IntrinsicP.h>
 
 #include <Xm/Xm.h>
 #include <Xm/Frame.h>
 #include <Xm/Label.h>
 #include <Xm/Screen.h>
 
+#include <Xsc/Help.h>
+
 #include "CueP.h"
 #include "DisplayP.h"
 #include "ObjectP.h"
@@ -32,7 +34,10 @@
 --------------------------------------------------------------------*/
 typedef struct _XscScreenRec
 {
-   Screen* xScreen;
+   Screen*    xScreen;
+   XscDisplay display;
+   Cardinal   referenceCount;   /* How many records point to this one? */
+   Boolean    closed;           /* Has the screen been closed? */
    Widget  cueShell;
    Widget  cueFrame;
    Widget  cueLabel;
@@ -40,13 +45,44 @@ typedef struct _XscScreenRec
    Widget  tipFrame;
    Widget  tipLabel;
    GC      gc;
+   XscScreenLayoutRec cueLayout;    /* As last set on the cue widgets */
+   XscScreenLayoutRec tipLayout;    /* As last set on the tip widgets */
+   XtWorkProcId        realizeWorkProc;
+   XscScreenColorsRec* colors;   /* Colors derived so far */
+   Cardinal            colorCount;
+   Cardinal            colorSize;
+   struct _XscScreenPixmapRec* pixmaps;  /* Most recently used first */
+   unsigned long       pixmapBytes;
+   unsigned long       pixmapCacheSize;
 }
 XscScreenRec;
 
+/*--------------------------------------------------------------------
+-- A tip or cue rendered into a pixmap, so exposes are a single copy
+--------------------------------------------------------------------*/
+typedef struct _XscScreenPixmapRec
+{
+   struct _XscScreenPixmapRec* next;
+   XscScreenPixmapKeyRec       key;
+   Pixmap                      pixmap;
+   unsigned long               bytes;
+}
+XscScreenPixmapRec;
+
 /*==============================================================================
                             Private prototypes
 ==============================================================================*/
 static void _destroyScreenCB( Widget, XtPointer, XtPointer );
+static void _freeScreen      ( XscScreen );
+
+static void    _getGeometry( Widget, Widget, XscScreenLayoutRec* );
+static void    _getLayout  ( Widget, Widget, Widget, XscScreenLayoutRec* );
+static void    _setLayout( Widget, Widget, Widget, XscScreenLayoutRec*, 
+                           XscScreenLayoutRec* );
+static Boolean _realizeWP( XtPointer );
+
+static void    _evictPixmaps( XscScreen, unsigned long );
+static Boolean _keysEqual   ( XscScreenPixmapKeyRec*, XscScreenPixmapKeyRec* );
 
 static void _renderCueEH( Widget, XtPointer, XEvent*, Boolean* );
 static void _renderTipEH( Widget, XtPointer, XEvent*, Boolean* );
@@ -104,12 +140,37 @@ XscScreen _XscScreenCreate( Widget obj )
    /*----------------------------
    -- Initialize data structure
    ----------------------------*/
-   self->xScreen = x_screen;
+   self->xScreen        = x_screen;
+   self->display        = _XscDisplayDeriveFromWidget( obj );
+   self->referenceCount = 0;
+   self->closed         = False;
+   self->colors         = NULL;
+   self->colorCount     = 0;
+   self->colorSize      = 0;
+   self->pixmaps        = NULL;
+   self->pixmapBytes    = 0;
+
+   self->pixmapCacheSize = XscHelpDefaultPixmapCacheSize;
+
+   assert( self->display );
+   _XscDisplayAddReference( self->display );
 
    /*-------------------------------------------------------------
    -- Create the GC that will be used for drawing on this screen
    -------------------------------------------------------------*/
-   self->gc = XCreateGC( x_display, RootWindowOfScreen( x_screen ), 0, NULL );
+   {
+      XGCValues values;
+
+      /*-----------------------------------------------------------
+      -- Copies from the pixmap cache never need exposure events
+      -----------------------------------------------------------*/
+      values.graphics_exposures = False;
+      self->gc = XCreateGC( 
+         x_display, 
+         RootWindowOfScreen( x_screen ), 
+         GCGraphicsExposures, 
+         &values );
+   }
 
    /*--------------------------------------------------------
    -- Create the widgets needed for the cues on this screen
@@ -120,7 +181,11 @@ XscScreen _XscScreenCreate( Widget obj )
       overrideShellWidgetClass,
       x_display,
       NULL, (Cardinal) 0 );
-   XtVaSetValues( self->cueShell, XtNallowShellResize, TRUE, NULL );
+   XtVaSetValues( 
+      self->cueShell, 
+      XtNallowShellResize,   TRUE, 
+      XtNmappedWhenManaged,  FALSE,
+      NULL );
 
    self->cueFrame = XtVaCreateManagedWidget(
       "xsc _ Cue Frame",
@@ -128,14 +193,18 @@ XscScreen _XscScreenCreate( Widget obj )
       self->cueShell,
       NULL );
 
-   /*---------------------------------------------------
-   -- Core is used as a very light-weight drawing area
-   ---------------------------------------------------*/
+   /*---------------------------------------------------------
+   -- Core is used as a very light-weight drawing area.  It
+   -- is given a size, since it may be realized (see 
+   -- _realizeWP) before any cue has been laid out.
+   ---------------------------------------------------------*/
    self->cueLabel = XtVaCreateManagedWidget(
       "xsc _ Cue Label",
       coreWidgetClass,
       self->cueFrame,
       XtNborderWidth,        0,
+      XtNwidth,              1,
+      XtNheight,             1,
       NULL );
 
    /*----------------------------------------------------------------
@@ -147,7 +216,7 @@ XscScreen _XscScreenCreate( Widget obj )
       ExposureMask, 
       False, 
       _renderCueEH,
-      NULL );
+      (XtPointer) self );
       
    /*--------------------------------------------------------
    -- Create the widgets needed for the tips on this screen
@@ -158,7 +227,11 @@ XscScreen _XscScreenCreate( Widget obj )
       overrideShellWidgetClass,
       x_display,
       NULL, (Cardinal) 0 );
-   XtVaSetValues( self->tipShell, XtNallowShellResize, TRUE, NULL );
+   XtVaSetValues( 
+      self->tipShell, 
+      XtNallowShellResize,   TRUE, 
+      XtNmappedWhenManaged,  FALSE,
+      NULL );
 
    self->tipFrame = XtVaCreateManagedWidget(
       "xsc _ Tip Frame",
@@ -166,14 +239,18 @@ XscScreen _XscScreenCreate( Widget obj )
       self->tipShell,
       NULL );
 
-   /*---------------------------------------------------
-   -- Core is used as a very light-weight drawing area
-   ---------------------------------------------------*/
+   /*---------------------------------------------------------
+   -- Core is used as a very light-weight drawing area.  It
+   -- is given a size, since it may be realized (see 
+   -- _realizeWP) before any tip has been laid out.
+   ---------------------------------------------------------*/
    self->tipLabel = XtVaCreateManagedWidget(
       "xsc _ Tip Label",
       coreWidgetClass,
       self->tipFrame,
       XtNborderWidth,        0,
+      XtNwidth,              1,
+      XtNheight,             1,
       NULL );
 
    /*----------------------------------------------------------------
@@ -185,8 +262,21 @@ XscScreen _XscScreenCreate( Widget obj )
       ExposureMask, 
       False, 
       _renderTipEH,
-      NULL );
+      (XtPointer) self );
       
+   _getLayout( self->cueShell, self->cueFrame, self->cueLabel, 
+               &self->cueLayout );
+   _getLayout( self->tipShell, self->tipFrame, self->tipLabel, 
+               &self->tipLayout );
+
+   /*---------------------------------------------------------------
+   -- The shells are not mapped when they are realized (XtPopup()
+   -- maps them), so they are realized while the application is
+   -- idle rather than when the first tip or cue is shown
+   ---------------------------------------------------------------*/
+   self->realizeWorkProc = XtAppAddWorkProc(
+      XtWidgetToApplicationContext( obj ), _realizeWP, (XtPointer) self );
+
    /*----------------------------------------------------
    -- Watch for when the screen is no longer being used
    ----------------------------------------------------*/
@@ -231,6 +321,27 @@ XscScreen _XscScreenDeriveFromWidget( Widget obj )
 }
 
 
+/*------------------------------------------------------------------------
+-- Object records keep a pointer to their screen record.  These functions
+-- make sure that the screen record outlives all of them.
+------------------------------------------------------------------------*/
+void _XscScreenAddReference( XscScreen self )
+{
+   self->referenceCount += 1;
+}
+
+void _XscScreenRemoveReference( XscScreen self )
+{
+   assert( self->referenceCount > 0 );
+
+   self->referenceCount -= 1;
+   if (self->closed && (self->referenceCount == 0))
+   {
+      _freeScreen( self );
+   }
+}
+
+
 Widget _XscScreenGetCueShell( XscScreen self ) { return self->cueShell; }
 Widget _XscScreenGetCueFrame( XscScreen self ) { return self->cueFrame; }
 Widget _XscScreenGetCueLabel( XscScreen self ) { return self->cueLabel; }
@@ -240,6 +351,79 @@ Widget _XscScreenGetTipFrame( XscScreen self ) { return self->tipFrame; }
 Widget _XscScreenGetTipLabel( XscScreen self ) { return self->tipLabel; }
 
 
+/*------------------------------------------------------------------------------
+-- This function returns the colors Motif derives from a background pixel.
+-- XmGetColors may have to allocate colors from the server, so what it
+-- returns is kept for each colormap and pixel.  Nothing is done if the
+-- caller's copy is already for this colormap and pixel.
+------------------------------------------------------------------------------*/
+void _XscScreenGetColors( 
+   XscScreen           self, 
+   Colormap            colormap, 
+   Pixel               base, 
+   XscScreenColorsRec* colors )
+{
+   Cardinal i;
+
+   if ((colors->colormap == colormap) && (colors->base == base))
+   {
+      return;
+   }
+
+   for (i = 0; i < self->colorCount; i++)
+   {
+      if ((self->colors[ i ].colormap == colormap) && 
+          (self->colors[ i ].base     == base    ))
+      {
+         *colors = self->colors[ i ];
+         return;
+      }
+   }
+
+   if (self->colorCount == self->colorSize)
+   {
+      self->colorSize += 8;
+      self->colors = (XscScreenColorsRec*) XtRealloc( 
+         (char*) self->colors, sizeof( XscScreenColorsRec ) * self->colorSize );
+   }
+
+   colors->colormap = colormap;
+   colors->base     = base;
+
+   _XscDisplayIncrementCounter( self->display, XmXSC_COUNTER_COLOR_DERIVATIONS );
+   XmGetColors(
+      self->xScreen,
+      colormap,
+      base,
+      &colors->foreground,
+      &colors->topShadow,
+      &colors->bottomShadow,
+      &colors->select );
+
+   self->colors[ self->colorCount++ ] = *colors;
+}
+
+
+/*------------------------------------------------------------------------------
+-- These functions set up the cue or tip widgets as the layout describes.
+-- Only the resources that differ from the ones set last time are set, so
+-- an unchanged tip causes no geometry negotiation at all.
+------------------------------------------------------------------------------*/
+void _XscScreenLayoutCue( XscScreen self, XscScreenLayoutRec* layout )
+{
+   _setLayout( 
+      self->cueShell, self->cueFrame, self->cueLabel, 
+      &self->cueLayout, layout );
+}
+
+void _XscScreenLayoutTip( XscScreen self, XscScreenLayoutRec* layout )
+{
+   _setLayout( 
+      self->tipShell, self->tipFrame, self->tipLabel, 
+      &self->tipLayout, layout );
+}
+
+
 void _XscScreenPopdownCue( XscScreen self )
 {
    XtPopdown( self->cueShell );
@@ -262,17 +446,16 @@ void _XscScreenPopupTip( XscScreen self )
 }
 
 
+/*------------------------------------------------------------------------------
+-- These functions make the label redraw its text.  The frame redraws its
+-- own shadows when they are changed, so only the label is cleared.  The
+-- display clears it once the pending events have been processed.
+------------------------------------------------------------------------------*/
 void _XscScreenRedrawCue( XscScreen self )
 {
    if (XtIsRealized( self->cueShell ))
    {
-      Display* x_display = XtDisplay( self->cueShell );
-
-      XClearArea( x_display, XtWindow( self->cueShell ), 0, 0, 0, 0, True );
-      XClearArea( x_display, XtWindow( self->cueFrame ), 0, 0, 0, 0, True );
-      XClearArea( x_display, XtWindow( self->cueLabel ), 0, 0, 0, 0, True );
-      
-      XFlush( x_display );
+      _XscDisplayRequestRedraw( self->display, self->cueLabel );
    }
 }
 
@@ -280,14 +463,75 @@ void _XscScreenRedrawTip( XscScreen self )
 {
    if (XtIsRealized( self->tipShell ))
    {
-      Display* x_display = XtDisplay( self->tipShell );
+      _XscDisplayRequestRedraw( self->display, self->tipLabel );
+   }
+}
 
-      XClearArea( x_display, XtWindow( self->tipShell ), 0, 0, 0, 0, True );
-      XClearArea( x_display, XtWindow( self->tipFrame ), 0, 0, 0, 0, True );
-      XClearArea( x_display, XtWindow( self->tipLabel ), 0, 0, 0, 0, True );
-      
-      XFlush( x_display );
+
+/*------------------------------------------------------------------------------
+-- This function returns a pixmap holding a tip or cue rendered as the key
+-- describes.  If it was not rendered before, a new pixmap is returned and
+-- 'created' is set; the caller must then render into it.  The pixmaps 
+-- belong to the screen, which keeps the most recently used ones within the
+-- cache size.  None is returned if the pixmap would not fit at all.
+------------------------------------------------------------------------------*/
+Pixmap _XscScreenGetPixmap(
+   XscScreen              self,
+   Widget                 w,
+   XscScreenPixmapKeyRec* key,
+   Boolean*               created )
+{
+   XscScreenPixmapRec** link;
+   XscScreenPixmapRec*  entry;
+   unsigned long        bytes;
+
+   *created = False;
+
+   for (link = &self->pixmaps; *link; link = &((*link)->next))
+   {
+      entry = *link;
+      if (_keysEqual( &entry->key, key ))
+      {
+         /*---------------------------------
+         -- Move it to the front and done
+         ---------------------------------*/
+         *link = entry->next;
+         entry->next   = self->pixmaps;
+         self->pixmaps = entry;
+
+         return entry->pixmap;
+      }
    }
+
+   bytes = (unsigned long) key->width * key->height;
+   if (w->core.depth > 16)
+   {
+      bytes *= 4;
+   }
+   else if (w->core.depth > 8)
+   {
+      bytes *= 2;
+   }
+
+   if ((bytes == 0) || (bytes > self->pixmapCacheSize) || !XtIsRealized( w ))
+   {
+      return None;
+   }
+
+   _evictPixmaps( self, self->pixmapCacheSize - bytes );
+
+   entry = XtNew( XscScreenPixmapRec );
+   entry->key    = *key;
+   entry->bytes  = bytes;
+   entry->pixmap = XCreatePixmap( 
+      XtDisplay( w ), XtWindow( w ), key->width, key->height, w->core.depth );
+
+   entry->next   = self->pixmaps;
+   self->pixmaps = entry;
+   self->pixmapBytes += bytes;
+
+   *created = True;
+   return entry->pixmap;
 }
 
 
@@ -308,37 +552,245 @@ static void _destroyScreenCB( Widget w, XtPointer cd, XtPointer cbd )
       -- Don't forget to clean up the GC
       ----------------------------------*/
       XFreeGC( XtDisplayOfObject( w ), screen->gc );
+      _evictPixmaps( screen, 0 );
+
+      if (screen->realizeWorkProc)
+      {
+         XtRemoveWorkProc( screen->realizeWorkProc );
+         screen->realizeWorkProc = (XtWorkProcId) NULL;
+      }
    
       /*--------------------------------------------------------------
       -- Remove the structure from the context manager and delete it
       --------------------------------------------------------------*/
       XDeleteContext( 
          XtDisplayOfObject( w ), (XID) screen->xScreen, _screenContextId );
-         
-      XtFree( (char*) screen );
+
+      /*--------------------------------------------------------------
+      -- Records that still point to this one will release it later
+      --------------------------------------------------------------*/
+      screen->closed = True;
+      if (screen->referenceCount == 0)
+      {
+         _freeScreen( screen );
+      }
    }
 }
 
 
+/*------------------------------------------------------------------------------
+-- This function frees the least recently used pixmaps until the cache 
+-- holds no more than the given number of bytes
+------------------------------------------------------------------------------*/
+static void _evictPixmaps( XscScreen self, unsigned long limit )
+{
+   XscScreenPixmapRec** link = &self->pixmaps;
+   unsigned long        kept = 0;
+
+   /*-----------------------------------------------------------
+   -- Keep entries from the front while they fit; everything 
+   -- after the first one that does not fit is released
+   -----------------------------------------------------------*/
+   while (*link && (kept + (*link)->bytes <= limit))
+   {
+      kept += (*link)->bytes;
+      link  = &((*link)->next);
+   }
+
+   while (*link)
+   {
+      XscScreenPixmapRec* entry = *link;
+
+      *link = entry->next;
+      XFreePixmap( DisplayOfScreen( self->xScreen ), entry->pixmap );
+      XtFree( (char*) entry );
+   }
+   self->pixmapBytes = kept;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function reads the part of a layout that is kept in the core fields
+------------------------------------------------------------------------------*/
+static void _getGeometry( Widget shell, Widget label, XscScreenLayoutRec* layout )
+{
+   layout->x           = shell->core.x;
+   layout->y           = shell->core.y;
+   layout->borderWidth = shell->core.border_width;
+   layout->borderColor = shell->core.border_pixel;
+   layout->width       = label->core.width;
+   layout->height      = label->core.height;
+   layout->background  = label->core.background_pixel;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function reads the layout the widgets were created with
+------------------------------------------------------------------------------*/
+static void _getLayout( 
+   Widget              shell, 
+   Widget              frame, 
+   Widget              label, 
+   XscScreenLayoutRec* layout )
+{
+   _getGeometry( shell, label, layout );
+
+   XtVaGetValues(
+      frame,
+      XmNshadowThickness,    &layout->shadowThickness,
+      XmNshadowType,         &layout->shadowType,
+      XmNtopShadowColor,     &layout->topShadow,
+      XmNbottomShadowColor,  &layout->bottomShadow,
+      NULL );
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function sets the resources of a layout that differ from the applied
+-- one.  The label is sized first, so the frame and shell grow around it.
+------------------------------------------------------------------------------*/
+static void _setLayout( 
+   Widget              shell, 
+   Widget              frame, 
+   Widget              label, 
+   XscScreenLayoutRec* applied,
+   XscScreenLayoutRec* layout )
+{
+   Arg      args[ 4 ];
+   Cardinal n;
+
+   n = 0;
+   if (layout->background != applied->background)
+   {
+      XtSetArg( args[ n ], XtNbackground, layout->background ); n++;
+   }
+   if (layout->width != applied->width)
+   {
+      XtSetArg( args[ n ], XtNwidth, layout->width ); n++;
+   }
+   if (layout->height != applied->height)
+   {
+      XtSetArg( args[ n ], XtNheight, layout->height ); n++;
+   }
+   if (n)
+   {
+      XtSetValues( label, args, n );
+   }
+
+   n = 0;
+   if (layout->shadowThickness != applied->shadowThickness)
+   {
+      XtSetArg( args[ n ], XmNshadowThickness, layout->shadowThickness ); n++;
+   }
+   if (layout->shadowType != applied->shadowType)
+   {
+      XtSetArg( args[ n ], XmNshadowType, layout->shadowType ); n++;
+   }
+   if (layout->topShadow != applied->topShadow)
+   {
+      XtSetArg( args[ n ], XmNtopShadowColor, layout->topShadow ); n++;
+   }
+   if (layout->bottomShadow != applied->bottomShadow)
+   {
+      XtSetArg( args[ n ], XmNbottomShadowColor, layout->bottomShadow ); n++;
+   }
+   if (n)
+   {
+      XtSetValues( frame, args, n );
+   }
+
+   n = 0;
+   if (layout->x != applied->x)
+   {
+      XtSetArg( args[ n ], XtNx, layout->x ); n++;
+   }
+   if (layout->y != applied->y)
+   {
+      XtSetArg( args[ n ], XtNy, layout->y ); n++;
+   }
+   if (layout->borderWidth != applied->borderWidth)
+   {
+      XtSetArg( args[ n ], XtNborderWidth, layout->borderWidth ); n++;
+   }
+   if (layout->borderColor != applied->borderColor)
+   {
+      XtSetArg( args[ n ], XtNborderColor, layout->borderColor ); n++;
+   }
+   if (n)
+   {
+      XtSetValues( shell, args, n );
+   }
+
+   /*------------------------------------------------------------------
+   -- Geometry management may not grant a request exactly, so the 
+   -- core fields are read back rather than assumed
+   ------------------------------------------------------------------*/
+   *applied = *layout;
+   _getGeometry( shell, label, applied );
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function determines if two pixmap keys describe the same rendering
+------------------------------------------------------------------------------*/
+static Boolean _keysEqual( XscScreenPixmapKeyRec* a, XscScreenPixmapKeyRec* b )
+{
+   return (a->serial     == b->serial    ) &&
+          (a->width      == b->width     ) &&
+          (a->height     == b->height    ) &&
+          (a->x          == b->x         ) &&
+          (a->y          == b->y         ) &&
+          (a->background == b->background) &&
+          (a->foreground == b->foreground) &&
+          (a->selected   == b->selected  );
+}
+
+
+/*------------------------------------------------------------------------------
+-- This work procedure realizes the (unmapped) cue and tip shells 
+------------------------------------------------------------------------------*/
+static Boolean _realizeWP( XtPointer cd )
+{
+   XscScreen self = (XscScreen) cd;
+
+   self->realizeWorkProc = (XtWorkProcId) NULL;
+
+   XtRealizeWidget( self->cueShell );
+   XtRealizeWidget( self->tipShell );
+
+   return True;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function releases the screen record
+------------------------------------------------------------------------------*/
+static void _freeScreen( XscScreen self )
+{
+   _XscDisplayRemoveReference( self->display );
+   XtFree( (char*) self->colors );
+   XtFree( (char*) self );
+}
+
+
 /*------------------------------------------------------------------------------
 -- This event handler is called when the cue needs to be rendered
 ------------------------------------------------------------------------------*/
 static void _renderCueEH( 
    Widget     cue_widget, 
-   XtPointer  not_used1, 
+   XtPointer  cd, 
    XEvent*    event, 
    Boolean*   not_used2 )
 {
-   XscDisplay display = _XscDisplayDeriveFromWidget( cue_widget );
+   XscScreen  screen = (XscScreen) cd;
    XscCue     cue;
       
-   assert( display );
-   
-   cue = _XscDisplayGetActiveCue( display );
-   if ((event->type == Expose) && (cue))
+   /*----------------------------------------------------------
+   -- The whole label is drawn at once, after the last expose
+   ----------------------------------------------------------*/
+   cue = _XscDisplayGetActiveCue( screen->display );
+   if ((event->type == Expose) && (event->xexpose.count == 0) && (cue))
    {
-      XscScreen screen = _XscScreenDeriveFromWidget( cue_widget );
-      
       _XscCueRender( cue, cue_widget, screen->gc );
    }
 }
@@ -349,21 +801,39 @@ static void _renderCueEH(
 ------------------------------------------------------------------------------*/
 static void _renderTipEH( 
    Widget     tip_widget, 
-   XtPointer  not_used1, 
+   XtPointer  cd, 
    XEvent*    event, 
    Boolean*   not_used2 )
 {
-   XscDisplay   display = _XscDisplayDeriveFromWidget( tip_widget );
+   XscScreen screen = (XscScreen) cd;
    XscObject object;
       
-   assert( display );
-   
-   object = _XscDisplayGetActiveTip( display );
-   if ((event->type == Expose) && (object))
+   /*----------------------------------------------------------
+   -- The whole label is drawn at once, after the last expose
+   ----------------------------------------------------------*/
+   object = _XscDisplayGetActiveTip( screen->display );
+   if ((event->type == Expose) && (event->xexpose.count == 0) && (object))
    {
-      XscScreen screen = _XscScreenDeriveFromWidget( tip_widget );
-      
       _XscTipRender( _XscObjectGetTip( object ), tip_widget, screen->gc );
    }
 }
 
+
+
+/*==============================================================================
+                               Public functions
+==============================================================================*/
+/*------------------------------------------------------------------------------
+-- This function sets how many bytes of pixmaps the widget's screen may keep
+-- for rendered tips and cues.  Zero turns the cache off.
+------------------------------------------------------------------------------*/
+void XscHelpSetPixmapCacheSize( Widget w, unsigned long bytes )
+{
+   XscScreen self = _XscScreenDeriveFromWidget( w );
+
+   if (self)
+   {
+      self->pixmapCacheSize = bytes;
+      _evictPixmaps( self, bytes );
+   }
+}
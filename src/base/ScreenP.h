@@ -32,11 +32,67 @@ extern "C" {
 /*==============================================================================
                                     Macros
 ==============================================================================*/
+/*---------------------------------------------------------------------
+-- How much pixmap memory each screen may keep for rendered tips and
+-- cues, unless set with XscHelpSetPixmapCacheSize()
+---------------------------------------------------------------------*/
+#define XscHelpDefaultPixmapCacheSize (512 * 1024)
 
 
 /*==============================================================================
                                Data types
 ==============================================================================*/
+/*---------------------------------------------------------------------
+-- The colors Motif derives from a background pixel.  A record keeps
+-- these along with the colormap and pixel they were derived from.
+---------------------------------------------------------------------*/
+typedef struct _XscScreenColorsRec
+{
+   Colormap colormap;
+   Pixel    base;
+   Pixel    foreground;
+   Pixel    topShadow;
+   Pixel    bottomShadow;
+   Pixel    select;
+}
+XscScreenColorsRec;
+
+/*---------------------------------------------------------------------
+-- Everything that decides what a rendered tip or cue looks like
+---------------------------------------------------------------------*/
+typedef struct _XscScreenPixmapKeyRec
+{
+   unsigned long serial;      /* Identifies the text and its resources */
+   Dimension     width;
+   Dimension     height;
+   Position      x;
+   Position      y;
+   Pixel         background;
+   Pixel         foreground;
+   Boolean       selected;
+}
+XscScreenPixmapKeyRec;
+
+
+/*---------------------------------------------------------------------
+-- Where and how a tip or cue is shown: the shell position and border,
+-- the frame shadow and the label size and background
+---------------------------------------------------------------------*/
+typedef struct _XscScreenLayoutRec
+{
+   Position      x;
+   Position      y;
+   Dimension     borderWidth;
+   Pixel         borderColor;
+   Dimension     shadowThickness;
+   unsigned char shadowType;
+   Pixel         topShadow;
+   Pixel         bottomShadow;
+   Dimension     width;
+   Dimension     height;
+   Pixel         background;
+}
+XscScreenLayoutRec;
 
 
 /*==============================================================================
@@ -47,14 +103,21 @@ void _XscScreenInitialize( XContext );
 XscScreen _XscScreenCreate( Widget );
 XscScreen _XscScreenDeriveFromWidget( Widget );
 
+void _XscScreenAddReference   ( XscScreen );
+void _XscScreenRemoveReference( XscScreen );
+
 Widget _XscScreenGetCueShell( XscScreen );
 Widget _XscScreenGetCueFrame( XscScreen );
 Widget _XscScreenGetCueLabel( XscScreen );
 GC     _XscScreenGetGC      ( XscScreen );
+void   _XscScreenGetColors  ( XscScreen, Colormap, Pixel, XscScreenColorsRec* );
 Widget _XscScreenGetTipShell( XscScreen );
 Widget _XscScreenGetTipFrame( XscScreen );
 Widget _XscScreenGetTipLabel( XscScreen );
 
+void _XscScreenLayoutCue( XscScreen, XscScreenLayoutRec* );
+void _XscScreenLayoutTip( XscScreen, XscScreenLayoutRec* );
+
 void _XscScreenPopdownCue( XscScreen );
 void _XscScreenPopupCue  ( XscScreen );
 
@@ -64,6 +127,8 @@ void _XscScreenPopupTip  ( XscScreen );
 void _XscScreenRedrawCue( XscScreen );
 void _XscScreenRedrawTip( XscScreen );
 
+Pixmap _XscScreenGetPixmap( XscScreen, Widget, XscScreenPixmapKeyRec*, Boolean* );
+
 
 #ifdef __cplusplus
 }  /* Close scope of 'extern "C"' declaration which encloses file. */
@@ -11,7 +11,8 @@
 #include <stdio.h>
 #include <string.h>
 
-#include <X11/Intrinsic.h>
+#include <X11/IntrinsicP.h>
+#include <X11/Xatom.h>
 
 #include <Xsc/Help.h>
 
@@ -30,14 +31,26 @@
 typedef struct _XscShellRec
 {
    Widget       shell;
+   XscDisplay   display;
    Widget       hintWidget;      /* Reference to hint display widget */
    Pixel        hintBackground;  /* Default background for the hint widget */
-   XtIntervalId hintUnmapTimer;  /* How long with no hints before unmapped? */
+   XscTimerEntryRec hintUnmapTimer; /* How long with no hints before unmapped? */
    Boolean      hintIsMapped;    /* Is the hint widget mapped? */
    Boolean      inFocus;
    Boolean      tipsEnabled;
    Boolean      cuesEnabled;
    Boolean      hintsEnabled;
+   Window       parentWindow;    /* Root window, WM frame, or None if unknown */
+   Boolean      positionValid;   /* Is the root position below known? */
+   int          rootX;           /* Root position of the shell window */
+   int          rootY;
+   Atom         extentsAtom;     /* _NET_FRAME_EXTENTS, once looked up */
+   Boolean      frameValid;      /* Are the frame extents below known? */
+   int          frameLeft;       /* How far the WM frame reaches past */
+   int          frameRight;      /* each side of the shell window     */
+   int          frameTop;
+   int          frameBottom;
+   unsigned int frameBorder;
 }
 XscShellRec;
 
@@ -46,7 +59,11 @@ XscShellRec;
 ==============================================================================*/
 static void _destroyShellCB( Widget, XtPointer, XtPointer );
 
-static void _hintUnmapTO( XtPointer, XtIntervalId* );
+static Boolean _fetchFrameExtents( XscShell );
+static void    _fetchRootPosition( XscShell );
+static void    _walkFrame        ( XscShell );
+
+static void _hintUnmapTO( XtPointer );
 
 static void _renderHintEH( Widget, XtPointer, XEvent*, Boolean* );
 static void _trackShellEH( Widget, XtPointer, XEvent*, Boolean* );
@@ -101,19 +118,70 @@ XscShell _XscShellCreate( Widget obj )
       shell_widget = XtParent( shell_widget );
    }
 
+   /*----------------------------------------------------------------
+   -- Several widgets (e.g., a menu shell and its WM shell) map to
+   -- the same record.  Object records keep a pointer to it, so it
+   -- must never be replaced by a second one.
+   ----------------------------------------------------------------*/
+   self = _XscShellDeriveFromWidget( shell_widget );
+   if (self)
+   {
+      return self;
+   }
+
    /*---------------------------------------------------------------
    -- Create and save the data structure associated with the shell
    ---------------------------------------------------------------*/
    self = XtNew( XscShellRec );
    self->shell           = shell_widget;
+   self->display         = _XscDisplayDeriveFromWidget( shell_widget );
    self->inFocus         = False;
    self->hintBackground  = 0;
-   self->hintUnmapTimer  = (XtIntervalId) NULL;
+   _XscTimerInitEntry( &self->hintUnmapTimer );
    self->hintIsMapped    = False;
    self->hintWidget      = NULL;
    self->tipsEnabled     = True;
    self->hintsEnabled    = True;
    self->cuesEnabled     = True;
+   self->parentWindow    = None;
+   self->positionValid   = False;
+   self->rootX           = 0;
+   self->rootY           = 0;
+   self->extentsAtom     = None;
+   self->frameValid      = False;
+   self->frameLeft       = 0;
+   self->frameRight      = 0;
+   self->frameTop        = 0;
+   self->frameBottom     = 0;
+   self->frameBorder     = 0;
+
+   assert( self->display );
+   _XscDisplayAddReference( self->display );
+
+   /*-----------------------------------------------------------------
+   -- A shell that is already realized may have been reparented, and
+   -- that ReparentNotify has gone by, so ask the server for its
+   -- parent.  Otherwise the parent stays unknown until one arrives.
+   -----------------------------------------------------------------*/
+   if (XtIsRealized( shell_widget ))
+   {
+      Window       root;
+      Window*      children;
+      unsigned int num_children;
+
+      _XscDisplayIncrementCounter( self->display, XmXSC_COUNTER_FRAME_QUERIES );
+
+      if (!XQueryTree( 
+             XtDisplay( shell_widget ), XtWindow( shell_widget ), 
+             &root, &self->parentWindow, &children, &num_children ))
+      {
+         self->parentWindow = None;
+      }
+      else if (children)
+      {
+         XFree( (void*) children );
+      }
+   }
 
    /*-------------------------------------------------------
    -- Add a callback to clean-up if the shell is destroyed
@@ -122,7 +190,8 @@ XscShell _XscShellCreate( Widget obj )
    
    XtAddEventHandler( 
       shell_widget, 
-      FocusChangeMask | LeaveWindowMask | StructureNotifyMask, 
+      FocusChangeMask | LeaveWindowMask | StructureNotifyMask | 
+         PropertyChangeMask, 
       False, 
       _trackShellEH, 
       self );
@@ -214,6 +283,52 @@ void _XscShellInstallHint( XscShell self, Widget w )
 }
 
 
+/*------------------------------------------------------------------------------
+-- This function returns the root geometry of the window manager's frame
+-- around the shell.  The shell's root position and the size of the frame
+-- decorations are cached, so this normally needs no round trip.  The
+-- cache is kept current by _trackShellEH.
+------------------------------------------------------------------------------*/
+void _XscShellGetFrameGeometry( 
+   XscShell      self, 
+   int*          x, 
+   int*          y, 
+   unsigned int* width, 
+   unsigned int* height, 
+   unsigned int* border )
+{
+   Widget shell = self->shell;
+
+   assert( XtIsRealized( shell ) );
+
+   if (!self->positionValid)
+   {
+      _fetchRootPosition( self );
+   }
+
+   if (!self->frameValid)
+   {
+      if (!_fetchFrameExtents( self ))
+      {
+         _walkFrame( self );
+      }
+      self->frameValid = True;
+   }
+
+   *x      = self->rootX - self->frameLeft;
+   *y      = self->rootY - self->frameTop;
+   *width  = shell->core.width  + self->frameLeft + self->frameRight;
+   *height = shell->core.height + self->frameTop  + self->frameBottom;
+   *border = self->frameBorder;
+}
+
+
+XscDisplay _XscShellGetDisplay( XscShell self )
+{
+   return self->display;
+}
+
+
 Pixel  _XscShellGetBackground( XscShell self )
 {
    return self->hintBackground;
@@ -243,8 +358,9 @@ void _XscShellEraseHint( XscShell self )
    ------------------------------------------------------------*/
    if (self->hintWidget)
    {
-      self->hintUnmapTimer = XtAppAddTimeOut(
-         XtWidgetToApplicationContext( self->hintWidget ),
+      _XscTimerStart(
+         _XscDisplayGetTimers( self->display ),
+         &self->hintUnmapTimer,
          100,
          _hintUnmapTO,
          (XtPointer) self );
@@ -254,19 +370,14 @@ void _XscShellEraseHint( XscShell self )
 
 void _XscShellDisplayHint( XscShell self )
 {
-   if (self->hintUnmapTimer)
+   if (_XscTimerIsPending( &self->hintUnmapTimer ))
    {
-      XtRemoveTimeOut( self->hintUnmapTimer );
-      self->hintUnmapTimer = (XtIntervalId) NULL;
+      _XscTimerCancel( 
+         _XscDisplayGetTimers( self->display ), &self->hintUnmapTimer );
 
       if (XtIsRealized( self->hintWidget ))
       {
-         XClearArea( 
-            XtDisplay( self->hintWidget ),
-            XtWindow(  self->hintWidget ),
-            0, 0, 0, 0,
-            True );
-         XFlush( XtDisplay( self->hintWidget ) );
+         _XscDisplayRequestRedraw( self->display, self->hintWidget );
       }
    }
    else
@@ -287,8 +398,7 @@ void _XscShellUpdateHint( XscShell self )
       ------------------------------------------------------*/
       Pixel      background;
       Widget     hint_widget = _XscShellGetHintWidget( self );
-      XscDisplay display     = _XscDisplayDeriveFromWidget( hint_widget );
-      XscObject  object      = _XscDisplayGetActiveHint( display );
+      XscObject  object      = _XscDisplayGetActiveHint( self->display );
       XscHint    hint        = _XscObjectGetHint( object );
 
 
@@ -322,12 +432,7 @@ void _XscShellUpdateHint( XscShell self )
 
       if (XtIsRealized( hint_widget ))
       {
-         XClearArea( 
-            XtDisplay( hint_widget ),
-            XtWindow(  hint_widget ),
-            0, 0, 0, 0,
-            True );
-         XFlush( XtDisplay( hint_widget ) );
+         _XscDisplayRequestRedraw( self->display, hint_widget );
       }
 }
 
@@ -391,28 +496,177 @@ static void _destroyShellCB( Widget shell, XtPointer cd, XtPointer cbd )
       -- Remove the structure from the context manager and delete it
       --------------------------------------------------------------*/
       XDeleteContext( XtDisplay( shell ), (XID)shell, _shellContextId );
-         
+
+      _XscTimerCancel( 
+         _XscDisplayGetTimers( self->display ), &self->hintUnmapTimer );
+
+      /*-------------------------------------------------------------
+      -- The object records that point to this one are all gone by
+      -- now; Xt destroys the descendants of a shell before it.
+      -------------------------------------------------------------*/
+      _XscDisplayRemoveReference( self->display );
       XtFree( (char*) self );
    }
    
    XtRemoveEventHandler( 
       shell, 
-      FocusChangeMask | LeaveWindowMask | StructureNotifyMask, 
+      FocusChangeMask | LeaveWindowMask | StructureNotifyMask | 
+         PropertyChangeMask, 
       False, 
       _trackShellEH, 
       self );
 }
 
 
+/*------------------------------------------------------------------------------
+-- This function reads the size of the frame decorations from the
+-- _NET_FRAME_EXTENTS property.  It returns False if the window manager
+-- does not provide it.
+------------------------------------------------------------------------------*/
+static Boolean _fetchFrameExtents( XscShell self )
+{
+   Display*       display = XtDisplay( self->shell );
+   Atom           type;
+   int            format;
+   unsigned long  count, remaining;
+   unsigned char* data   = NULL;
+   Boolean        found  = False;
+
+   if (self->extentsAtom == None)
+   {
+      self->extentsAtom = XInternAtom( display, "_NET_FRAME_EXTENTS", False );
+   }
+
+   _XscDisplayIncrementCounter( self->display, XmXSC_COUNTER_FRAME_QUERIES );
+
+   if (XGetWindowProperty( 
+          display, XtWindow( self->shell ), self->extentsAtom,
+          0, 4, False, XA_CARDINAL, 
+          &type, &format, &count, &remaining, &data ) == Success)
+   {
+      if ((type == XA_CARDINAL) && (format == 32) && (count == 4))
+      {
+         long* extents = (long*) data;
+
+         self->frameLeft   = (int) extents[ 0 ];
+         self->frameRight  = (int) extents[ 1 ];
+         self->frameTop    = (int) extents[ 2 ];
+         self->frameBottom = (int) extents[ 3 ];
+         self->frameBorder = 0;
+         found = True;
+      }
+      if (data) XFree( (void*) data );
+   }
+   return found;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function asks the server where the shell window is on the root
+------------------------------------------------------------------------------*/
+static void _fetchRootPosition( XscShell self )
+{
+   Widget shell = self->shell;
+   Window child;
+   int    x, y;
+
+   _XscDisplayIncrementCounter( self->display, XmXSC_COUNTER_FRAME_QUERIES );
+
+   XTranslateCoordinates(
+      XtDisplay( shell ),
+      XtWindow( shell ),
+      RootWindowOfScreen( XtScreen( shell ) ),
+      0, 0, &x, &y, &child );
+
+   /*-----------------------------------------------------------
+   -- Like a ConfigureNotify, keep the outer corner of the border
+   -----------------------------------------------------------*/
+   self->rootX         = x - shell->core.border_width;
+   self->rootY         = y - shell->core.border_width;
+   self->positionValid = True;
+}
+
+
+/*------------------------------------------------------------------------------
+-- Without _NET_FRAME_EXTENTS, the frame is found by walking up the window
+-- tree until the root (or a virtual root) is reached.  Only the distance
+-- between the frame and the shell is kept; it does not change when the
+-- shell is moved.
+------------------------------------------------------------------------------*/
+static void _walkFrame( XscShell self )
+{
+   Widget       shell   = self->shell;
+   Display*     display = XtDisplay( shell );
+   Screen*      screen  = XtScreen( shell );
+   Window       frame, parent, root;
+   Window*      children;
+   int          frame_x, frame_y;
+   int          parent_x, parent_y;
+   unsigned int frame_width , frame_height , frame_border;
+   unsigned int parent_width, parent_height, parent_border, parent_depth;
+   unsigned int num_children;
+
+   frame        = XtWindow( shell );
+   frame_x      = self->rootX;
+   frame_y      = self->rootY;
+   frame_width  = shell->core.width;
+   frame_height = shell->core.height;
+   frame_border = shell->core.border_width;
+
+   for(;;)
+   {
+      _XscDisplayIncrementCounter( self->display, XmXSC_COUNTER_FRAME_QUERIES );
+
+      XQueryTree( display, frame, &root, &parent, &children, &num_children);
+      if (children) XFree( (void*) children );
+
+      if (parent == root) break;
+
+      _XscDisplayIncrementCounter( self->display, XmXSC_COUNTER_FRAME_QUERIES );
+
+      XGetGeometry( 
+         display, 
+         parent, 
+         &root, 
+         &parent_x, 
+         &parent_y,
+         &parent_width,
+         &parent_height,
+         &parent_border,
+         &parent_depth );
+
+      if (parent_width == WidthOfScreen( screen ))
+      {
+         if (parent_height == HeightOfScreen( screen ))
+         {
+            break;
+         }
+      }
+      frame        = parent;
+      frame_x      = parent_x;
+      frame_y      = parent_y;
+      frame_width  = parent_width;
+      frame_height = parent_height;
+      frame_border = parent_border;
+   }
+
+   self->frameLeft   = self->rootX - frame_x;
+   self->frameTop    = self->rootY - frame_y;
+   self->frameRight  = 
+      frame_x + (int) frame_width  - self->rootX - (int) shell->core.width;
+   self->frameBottom = 
+      frame_y + (int) frame_height - self->rootY - (int) shell->core.height;
+   self->frameBorder = frame_border;
+}
+
+
 /*------------------------------------------------------------------------------
 -- This timer is called when it is time to unmap the hint display widget
 ------------------------------------------------------------------------------*/
-static void _hintUnmapTO( XtPointer cd, XtIntervalId* not_used )
+static void _hintUnmapTO( XtPointer cd )
 {
    XscShell self = (XscShell) cd;
    
-   self->hintUnmapTimer = (XtIntervalId) NULL;
-   
    XtUnmapWidget( self->hintWidget );
    self->hintIsMapped = False;
 }
@@ -428,17 +682,24 @@ static void _renderHintEH(
    Boolean*   not_used2 )
 {
    XscShell     self   = (XscShell) shell;
-   XscDisplay   display = _XscDisplayDeriveFromWidget( hint_widget );
    XscObject object;
    
-   assert( display );
-   
-   object = _XscDisplayGetActiveHint( display );
+   object = _XscDisplayGetActiveHint( self->display );
    if ((event->type == Expose) && (object))
    {
+      /*------------------------------------------------------------
+      -- The GC must come from the screen of the hint widget; the
+      -- active hint may belong to a shell on another screen
+      ------------------------------------------------------------*/
       XscScreen screen = _XscScreenDeriveFromWidget( hint_widget );
-      GC        gc     = _XscScreenGetGC( screen );
+      GC        gc;
       XscHint   hint   = _XscObjectGetHint( object );
+
+      if (!screen)
+      {
+         return;
+      }
+      gc = _XscScreenGetGC( screen );
       
       /*--------------------------
       -- This keeps the GC happy
@@ -468,25 +729,54 @@ static void _trackShellEH(
       xsc_shell->inFocus = False;
       break;
       
+   case ReparentNotify:
+      xsc_shell->parentWindow  = event->xreparent.parent;
+      xsc_shell->positionValid = False;
+      xsc_shell->frameValid    = False;
+      break;
+
+   case PropertyNotify:
+      if (event->xproperty.atom == xsc_shell->extentsAtom)
+      {
+         xsc_shell->frameValid = False;
+      }
+      break;
+
    case ConfigureNotify:
-      if (xsc_shell->inFocus)
+      /*----------------------------------------------------------------
+      -- Synthetic events (sent by the window manager when it moves
+      -- the frame) and events of an unparented shell are relative to
+      -- the root.  Real events inside a frame are not, nor can they
+      -- be trusted while the parent is still unknown.
+      ----------------------------------------------------------------*/
+      if (event->xconfigure.send_event ||
+          (xsc_shell->parentWindow == 
+             RootWindowOfScreen( XtScreen( shell ) )))
+      {
+         xsc_shell->rootX         = event->xconfigure.x;
+         xsc_shell->rootY         = event->xconfigure.y;
+         xsc_shell->positionValid = True;
+      }
+      else
       {
-         XscDisplay xsc_display = _XscDisplayDeriveFromWidget( shell );
-         XscCue     xsc_cue     = _XscDisplayGetActiveCue( xsc_display );
+         xsc_shell->positionValid = False;
+      }
 
-         if (xsc_cue)
+      /*----------------------------------------------------------
+      -- The cue follows the shell, but only once the burst of
+      -- events from an interactive move has been processed
+      ----------------------------------------------------------*/
+      if (xsc_shell->inFocus)
+      {
+         if (_XscDisplayGetActiveCue( xsc_shell->display ))
          {
-            _XscCuePopup( xsc_cue );
-            
+            _XscDisplayRequestCueMove( xsc_shell->display );
          }
       }
       break;
    
    case LeaveNotify:
-      {
-         XscDisplay xsc_display = _XscDisplayDeriveFromWidget( shell );
-         _XscDisplayPrimeTipRestore( xsc_display );
-      }
+      _XscDisplayPrimeTipRestore( xsc_shell->display, event->xcrossing.time );
       break;
    }
 }
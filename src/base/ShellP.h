@@ -24,6 +24,7 @@ typedef struct _XscShellRec *XscShell;
 /*==============================================================================
                               Private Includes
 ==============================================================================*/
+#include "DisplayP.h"
 
 
 #ifdef __cplusplus
@@ -48,8 +49,13 @@ void _XscShellInitialize( XContext );
 XscShell _XscShellCreate( Widget );
 XscShell _XscShellDeriveFromWidget( Widget );
 
+XscDisplay _XscShellGetDisplay( XscShell );
+
 void _XscShellInstallHint( XscShell, Widget );
 
+void _XscShellGetFrameGeometry( 
+   XscShell, int*, int*, unsigned int*, unsigned int*, unsigned int* );
+
 Pixel  _XscShellGetBackground( XscShell );
 Widget _XscShellGetHintWidget( XscShell );
 
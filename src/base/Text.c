@@ -15,7 +15,10 @@
 #include <Xsc/Help.h>
 #include <Xsc/StrDefs.h>
 
+#include "DisplayP.h"
+#include "ResourceP.h"
 #include "TextP.h"
+#include "TopicP.h"
 
 /*==============================================================================
                                Private data types
@@ -32,10 +35,23 @@ typedef struct _XscTextNameRec
 }
 XscTextNameRec;
 
-typedef struct _XscTextRec
+/*------------------------------------------------------------------------
+-- The topic and its compound string are kept in a body that widgets with
+-- the same topic and text resources share.  Shared bodies are found
+-- through the display's intern table and are never changed; a text
+-- record gets a private copy before it is changed (see _unshare).
+------------------------------------------------------------------------*/
+typedef struct _XscTextBodyRec
 {
+   struct _XscTextBodyRec* next;    /* Next body in the same bucket */
+   unsigned long   hash;
+   Cardinal        referenceCount;  /* How many text records use this? */
+   Boolean         interned;        /* Is it in the intern table? */
+   unsigned long   serial;          /* Changes whenever the text does */
    String          str;
+   Boolean         mapped;          /* Is str in a topic catalog? */
    XmString        cs;
+   Boolean         dirty;           /* Must cs (and the extent) be rebuilt? */
    Dimension       width;
    Dimension       height;
    XmFontList      fontList;
@@ -46,14 +62,75 @@ typedef struct _XscTextRec
    unsigned char   showName;
    XscTextNameRec* textName;
 }
+XscTextBodyRec, *XscTextBody;
+
+typedef struct _XscTextRec
+{
+   XscDisplay      display;         /* Owner of the pool we came from */
+   Widget          widget;          /* Whose text is it? */
+   XscTextBody     body;
+   XrmQuark        topic;           /* Topic referred to, if any */
+}
 XscTextRec;
 
+typedef struct _XscTextTableRec
+{
+   XscTextBody*    buckets;
+   Cardinal        size;            /* Always a power of two */
+   Cardinal        count;
+}
+XscTextTableRec;
+
+/*------------------------------------------------------------------------
+-- The converters collect the pieces of a compound string in a table and
+-- join them at the end.  Most topics fit in the local array.
+------------------------------------------------------------------------*/
+#define XscTextLocalSegments 32
+
+/*------------------------------------------------------------------------
+-- The intern table grows when it holds more bodies than buckets
+------------------------------------------------------------------------*/
+#define XscTextTableInitialSize 64
+
+typedef struct _XscTextSegmentTableRec
+{
+   XmString* segments;
+   Cardinal  count;
+   Cardinal  size;
+   XmString  local[ XscTextLocalSegments ];
+}
+XscTextSegmentTableRec;
+
 
 /*==============================================================================
                                Private prototypes
 ==============================================================================*/
 static void _buildFullName( Widget, char* );
 static void _deriveName( XscText, Widget );
+static void _ensureCompoundString( XscText );
+static void _forgetTopic( XscText );
+
+static XscTextBody   _createBody ( XscDisplay );
+static Boolean       _equalBodies( XscTextBody, XscTextBody );
+static unsigned long _hashBody   ( XscTextBody );
+static void          _intern     ( XscText );
+static void          _releaseBody( XscDisplay, XscTextBody );
+static void          _removeBody ( XscTextTable, XscTextBody );
+static void          _unshare    ( XscText );
+
+static void     _appendSegment  ( XscTextSegmentTableRec*, XmString );
+static void     _initSegments   ( XscTextSegmentTableRec* );
+static XmString _joinSegments   ( XscTextSegmentTableRec* );
+
+
+/*==============================================================================
+                           Static global variables
+==============================================================================*/
+/*-----------------------------------------------------------------------
+-- Every version of every body gets its own serial number, so something
+-- drawn from a body can be recognized later
+-----------------------------------------------------------------------*/
+static unsigned long _lastSerial = 0;
 
 /*==============================================================================
                                Protected functions
@@ -62,17 +139,15 @@ static void _deriveName( XscText, Widget );
 /*----------------------------------------------------------------------------
 -- This function is used to create the data structure
 ------------------------------------------------------------------------------*/
-XscText _XscTextCreate()
+XscText _XscTextCreate( XscDisplay display )
 {
-   XscText self = XtNew( XscTextRec );
-   
-   memset( (char*) self, '\0', sizeof( *self ) );
+   XscText self = (XscText) _XscDisplayAllocRecord( 
+      display, XmXSC_POOL_TEXT, sizeof( XscTextRec ) );
    
-   self->str         = NULL;
-   self->cs          = NULL;
-   self->fontList    = NULL;
-   self->fontListTag = NULL;
-   self->textName    = NULL;
+   self->display = display;
+   self->widget  = NULL;
+   self->body    = _createBody( display );
+   self->topic   = NULLQUARK;
    
    return self;
 }
@@ -83,17 +158,31 @@ XscText _XscTextCreate()
 ------------------------------------------------------------------------------*/
 void _XscTextDestroy( XscText self )
 {
-   XtFree( self->fontListTag );
-   XtFree( self->str);
-   
-   if (self->cs) XmStringFree( self->cs );
-   
-   if (self->textName)
-   {
-      XtFree( self->textName->name );
-      if (self->textName->cs) XmStringFree( self->textName->cs );
-      XtFree( (char*) self->textName );
-   }
+   _forgetTopic( self );
+   _releaseBody( self->display, self->body );
+   _XscDisplayFreeRecord( self->display, XmXSC_POOL_TEXT, (XtPointer) self );
+}
+
+
+/*------------------------------------------------------------------------------
+-- These functions create and delete the table a display uses to find the
+-- text bodies its widgets can share
+------------------------------------------------------------------------------*/
+XscTextTable _XscTextTableCreate( void )
+{
+   XscTextTable self = XtNew( XscTextTableRec );
+
+   self->size    = XscTextTableInitialSize;
+   self->count   = 0;
+   self->buckets = (XscTextBody*) XtCalloc( 
+      self->size, sizeof( XscTextBody ) );
+
+   return self;
+}
+
+void _XscTextTableDestroy( XscTextTable self )
+{
+   XtFree( (char*) self->buckets );
    XtFree( (char*) self );
 }
 
@@ -109,12 +198,12 @@ void _XscTextConvertSegmented( XscText self, Widget w )
 {
    String tag;
    String buffer, line_begin, line_end;
-   XmString cs_text, cs_build, cs_tmp;
+   XscTextSegmentTableRec table;
 
    tag = XmFONTLIST_DEFAULT_TAG;
 
-   buffer = XtNewString( self->str );
-   cs_build = NULL;
+   buffer = XtNewString( self->body->str );
+   _initSegments( &table );
 
    for (line_end = buffer; line_end && *line_end;)
    {
@@ -129,19 +218,14 @@ void _XscTextConvertSegmented( XscText self, Widget w )
          --------------------------------*/
          if (*line_end == '\n')
          {
-            XmString cs_sep;
-            
             *line_end = '\0';
             line_end++;
 
             /*--------------------------------------------------
             -- Append the new line to the end of the (cs) text
             --------------------------------------------------*/
-            cs_tmp  = XmStringCreate( line_begin, tag );
-            cs_sep  = XmStringSeparatorCreate();
-            cs_text = XmStringConcat( cs_tmp, cs_sep );
-            XmStringFree( cs_tmp ); cs_tmp = NULL;
-            XmStringFree( cs_sep ); cs_sep = NULL;
+            _appendSegment( &table, XmStringCreate( line_begin, tag ) );
+            _appendSegment( &table, XmStringSeparatorCreate() );
          }
          /*----------------------------
          -- Look for escape sequences
@@ -154,7 +238,7 @@ void _XscTextConvertSegmented( XscText self, Widget w )
             /*------------------------------------------------------------------
             -- Build the compound string up to the (potential) escape sequence
             ------------------------------------------------------------------*/
-            cs_text = XmStringCreate( line_begin, tag );
+            _appendSegment( &table, XmStringCreate( line_begin, tag ) );
 
             /*---------------------------------------------------
             -- Check for a change font escape sequence: @f[tag]
@@ -224,46 +308,25 @@ void _XscTextConvertSegmented( XscText self, Widget w )
 
                if (cs_dir)
                {
-                  cs_tmp = cs_text;
-                  cs_text = XmStringConcat( cs_tmp, cs_dir );
-                  XmStringFree( cs_dir ); cs_dir = NULL;
-                  XmStringFree( cs_tmp ); cs_tmp = NULL;
+                  _appendSegment( &table, cs_dir );
                }
             }
             else if (*line_end == '@')
             {
-               XmString cs_at;
-               
                line_end++;
                
-               cs_tmp = cs_text;
-               cs_at = XmStringCreate( "@", tag );
-               cs_text = XmStringConcat( cs_tmp, cs_at );
-               XmStringFree( cs_at );  cs_at  = NULL;
-               XmStringFree( cs_tmp ); cs_tmp = NULL;
+               _appendSegment( &table, XmStringCreate( "@", tag ) );
             }
          }
       }
       else
       {
-         cs_text = XmStringCreate( line_begin, tag );
-      }
-
-      if (cs_build)
-      {
-         cs_tmp = cs_build;
-         cs_build = XmStringConcat( cs_tmp, cs_text );
-         XmStringFree( cs_tmp );
-         XmStringFree( cs_text );
-      }
-      else
-      {
-         cs_build = cs_text;
+         _appendSegment( &table, XmStringCreate( line_begin, tag ) );
       }
    }
    XtFree( buffer );
 
-   self->cs = cs_build;
+   self->body->cs = _joinSegments( &table );
 }
 
 
@@ -275,19 +338,19 @@ void _XscTextConvertFontTag( XscText self, Widget w )
 {
    String tag;
    String buffer, line_begin, line_end;
-   XmString cs_text, cs_sep, cs_build, cs_tmp;
+   XscTextSegmentTableRec table;
 
-   if (self->fontListTag)
+   if (self->body->fontListTag)
    {
-      tag = self->fontListTag;
+      tag = self->body->fontListTag;
    }
    else
    {
       tag = XmFONTLIST_DEFAULT_TAG;
    }
 
-   buffer = XtNewString( self->str );
-   cs_build = NULL;
+   buffer = XtNewString( self->body->str );
+   _initSegments( &table );
 
    for (line_end = buffer; line_end && *line_end;)
    {
@@ -299,32 +362,17 @@ void _XscTextConvertFontTag( XscText self, Widget w )
          *line_end = '\0';
          line_end++;
 
-         cs_tmp  = XmStringCreate( line_begin, tag );
-         cs_sep  = XmStringSeparatorCreate();
-         cs_text = XmStringConcat( cs_tmp, cs_sep );
-         XmStringFree( cs_tmp );
-         XmStringFree( cs_sep );
-      }
-      else
-      {
-         cs_text  = XmStringCreate( line_begin, tag );
-      }
-
-      if (cs_build)
-      {
-         cs_tmp = cs_build;
-         cs_build = XmStringConcat( cs_tmp, cs_text );
-         XmStringFree( cs_tmp );
-         XmStringFree( cs_text );
+         _appendSegment( &table, XmStringCreate( line_begin, tag ) );
+         _appendSegment( &table, XmStringSeparatorCreate() );
       }
       else
       {
-         cs_build = cs_text;
+         _appendSegment( &table, XmStringCreate( line_begin, tag ) );
       }
    }
    XtFree( buffer );
 
-   self->cs = cs_build;
+   self->body->cs = _joinSegments( &table );
 }
 
 
@@ -336,19 +384,19 @@ void _XscTextConvertStandard( XscText self, Widget w )
    XrmValue to, from;
    Boolean converted;
 
-   char* buffer = XtNewString( self->str );
+   char* buffer = XtNewString( self->body->str );
    
    from.size = strlen( buffer ) + 1;
    from.addr = buffer;
 
    to.size = sizeof( XmString );
-   to.addr = (void*) &(self->cs);
+   to.addr = (void*) &(self->body->cs);
 
    converted  = XtConvertAndStore( w, XmRString, &from, XmRXmString, &to );
 
    if (!converted)
    {
-      self->cs = XmStringCreate( buffer, XmFONTLIST_DEFAULT_TAG );
+      self->body->cs = XmStringCreate( buffer, XmFONTLIST_DEFAULT_TAG );
    }
    
    XtFree( buffer );
@@ -361,17 +409,20 @@ void _XscTextConvertStandard( XscText self, Widget w )
 ------------------------------------------------------------------------------*/
 void _XscTextCreateCompoundString( XscText self, Widget w )
 {
-   if (self->cs)
+   self->body->dirty  = False;
+   self->widget = w;
+
+   if (self->body->cs)
    {
-      XmStringFree( self->cs );
-      self->cs = NULL;
+      XmStringFree( self->body->cs );
+      self->body->cs = NULL;
    }
    
-   assert( self->fontList );
+   assert( self->body->fontList );
    
-   if (self->str)
+   if (self->body->str)
    {
-      switch (self->converter)
+      switch (self->body->converter)
       {
       case XmXSC_STRING_CONVERTER_SEGMENTED:
          _XscTextConvertSegmented( self, w );
@@ -387,45 +438,45 @@ void _XscTextCreateCompoundString( XscText self, Widget w )
          break;
       }
       XmStringExtent( 
-         self->fontList, 
-         self->cs, 
-         &(self->width), 
-         &(self->height) );
+         self->body->fontList, 
+         self->body->cs, 
+         &(self->body->width), 
+         &(self->body->height) );
    }
    else
    {
-      self->width  = 0;
-      self->height = 0;
+      self->body->width  = 0;
+      self->body->height = 0;
    }
 
-   if (self->showName != XmXSC_SHOW_NAME_NONE)
+   if (self->body->showName != XmXSC_SHOW_NAME_NONE)
    {
-      if (self->textName == NULL)
+      if (self->body->textName == NULL)
       {
-      	 self->textName = XtNew( XscTextNameRec );
-	 self->textName->name = NULL;
-	 self->textName->cs = NULL;
+      	 self->body->textName = XtNew( XscTextNameRec );
+	 self->body->textName->name = NULL;
+	 self->body->textName->cs = NULL;
       }
       _deriveName( self, w );
       
-      if (self->textName->name)
+      if (self->body->textName->name)
       {
-      	 self->textName->cs = XmStringCreateLocalized( self->textName->name );
+      	 self->body->textName->cs = XmStringCreateLocalized( self->body->textName->name );
 	 
 	 XmStringExtent(
-	    self->fontList,
-	    self->textName->cs,
-	    &(self->textName->width),
-	    &(self->textName->height) );
+	    self->body->fontList,
+	    self->body->textName->cs,
+	    &(self->body->textName->width),
+	    &(self->body->textName->height) );
       }
    }
    else
    {
-      if (self->textName)
+      if (self->body->textName)
       {
-      	 XtFree( self->textName->name );
-	 if (self->textName->cs) XmStringFree( self->textName->cs );
-	 self->textName = NULL;
+      	 XtFree( self->body->textName->name );
+	 if (self->body->textName->cs) XmStringFree( self->body->textName->cs );
+	 self->body->textName = NULL;
       }
    }
    
@@ -436,7 +487,7 @@ static void _deriveName( XscText self, Widget w )
    char buffer[ 1024 ];
    
    *buffer = '\0';
-   switch (self->showName)
+   switch (self->body->showName)
    {
    case XmXSC_SHOW_NAME_NONE:
       break;
@@ -470,7 +521,34 @@ static void _deriveName( XscText self, Widget w )
    
    if (*buffer)
    {
-      self->textName->name = XtNewString( buffer );
+      self->body->textName->name = XtNewString( buffer );
+   }
+}
+
+
+/*------------------------------------------------------------------------------
+-- The compound string and its extent are only built when they are first
+-- needed.  Most widgets never show their help.
+------------------------------------------------------------------------------*/
+static void _ensureCompoundString( XscText self )
+{
+   if (self->body->dirty)
+   {
+      _XscTextCreateCompoundString( self, self->widget );
+   }
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function drops the text's reference to a topic
+------------------------------------------------------------------------------*/
+static void _forgetTopic( XscText self )
+{
+   if (self->topic != NULLQUARK)
+   {
+      _XscTopicTableRemoveReference( 
+         _XscDisplayGetTopics( self->display ), self->topic, (XtPointer) self );
+      self->topic = NULLQUARK;
    }
 }
 
@@ -490,54 +568,412 @@ static void _buildFullName( Widget w, char* buffer )
 }
 
 
+/*------------------------------------------------------------------------------
+-- This function allocates an empty, private text body
+------------------------------------------------------------------------------*/
+static XscTextBody _createBody( XscDisplay display )
+{
+   XscTextBody body = (XscTextBody) _XscDisplayAllocRecord(
+      display, XmXSC_POOL_TEXT_BODY, sizeof( XscTextBodyRec ) );
+
+   body->referenceCount = 1;
+   body->serial         = ++_lastSerial;
+
+   return body;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function drops a reference to a text body and frees it when the
+-- last text record lets go of it
+------------------------------------------------------------------------------*/
+static void _releaseBody( XscDisplay display, XscTextBody body )
+{
+   if (--body->referenceCount > 0)
+   {
+      return;
+   }
+
+   if (body->interned)
+   {
+      _removeBody( _XscDisplayGetTextTable( display ), body );
+   }
+
+   XtFree( body->fontListTag );
+   if (!body->mapped) XtFree( body->str );
+   
+   if (body->cs) XmStringFree( body->cs );
+   
+   if (body->textName)
+   {
+      XtFree( body->textName->name );
+      if (body->textName->cs) XmStringFree( body->textName->cs );
+      XtFree( (char*) body->textName );
+   }
+   _XscDisplayFreeRecord( display, XmXSC_POOL_TEXT_BODY, (XtPointer) body );
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function makes sure the text record is the only user of its body,
+-- so the body can be changed.  A shared body is copied; the compound 
+-- string of the copy is rebuilt when it is needed.  A body that is only
+-- ours leaves the intern table, since its key is about to change.
+------------------------------------------------------------------------------*/
+static void _unshare( XscText self )
+{
+   XscTextBody body = self->body;
+
+   if (body->referenceCount > 1)
+   {
+      XscTextBody copy = _createBody( self->display );
+
+      copy->str         = (body->str && !body->mapped) ? 
+         XtNewString( body->str ) : body->str;
+      copy->mapped      = body->mapped;
+      copy->dirty       = True;
+      copy->fontList    = body->fontList;
+      copy->fontListTag = 
+         body->fontListTag ? XtNewString( body->fontListTag ) : NULL;
+      copy->alignment   = body->alignment;
+      copy->direction   = body->direction;
+      copy->converter   = body->converter;
+      copy->showName    = body->showName;
+
+      body->referenceCount -= 1;
+      self->body = copy;
+   }
+   else if (body->interned)
+   {
+      _removeBody( _XscDisplayGetTextTable( self->display ), body );
+   }
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function looks for a body equal to ours in the intern table.  If
+-- there is one, we share it; otherwise ours is added for others to share.
+-- Bodies that show the widget name differ from widget to widget and are
+-- never shared.
+------------------------------------------------------------------------------*/
+static void _intern( XscText self )
+{
+   XscTextTable table = _XscDisplayGetTextTable( self->display );
+   XscTextBody  body  = self->body;
+   XscTextBody  match;
+   Cardinal     index;
+
+   if (!table || body->interned || (body->showName != XmXSC_SHOW_NAME_NONE))
+   {
+      return;
+   }
+
+   body->hash = _hashBody( body );
+   index = body->hash & (table->size - 1);
+
+   for (match = table->buckets[ index ]; match; match = match->next)
+   {
+      if ((match->hash == body->hash) && _equalBodies( match, body ))
+      {
+         match->referenceCount += 1;
+         self->body = match;
+         _releaseBody( self->display, body );
+         return;
+      }
+   }
+
+   /*-----------------------------------------------------------
+   -- Double the buckets before the chains start to get long
+   -----------------------------------------------------------*/
+   if (table->count >= table->size)
+   {
+      Cardinal     size    = table->size * 2;
+      XscTextBody* buckets = (XscTextBody*) XtCalloc( 
+         size, sizeof( XscTextBody ) );
+      Cardinal     i;
+
+      for (i = 0; i < table->size; i++)
+      {
+         XscTextBody next;
+
+         for (match = table->buckets[ i ]; match; match = next)
+         {
+            next = match->next;
+            match->next = buckets[ match->hash & (size - 1) ];
+            buckets[ match->hash & (size - 1) ] = match;
+         }
+      }
+      XtFree( (char*) table->buckets );
+      table->buckets = buckets;
+      table->size    = size;
+
+      index = body->hash & (table->size - 1);
+   }
+
+   body->next     = table->buckets[ index ];
+   body->interned = True;
+   table->buckets[ index ] = body;
+   table->count += 1;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function takes a body out of the intern table
+------------------------------------------------------------------------------*/
+static void _removeBody( XscTextTable table, XscTextBody body )
+{
+   XscTextBody* link = &(table->buckets[ body->hash & (table->size - 1) ]);
+
+   while (*link && (*link != body))
+   {
+      link = &((*link)->next);
+   }
+
+   if (*link)
+   {
+      *link = body->next;
+      table->count -= 1;
+   }
+   body->next     = NULL;
+   body->interned = False;
+}
+
+
+/*------------------------------------------------------------------------------
+-- These functions compute the key of a body in the intern table: the
+-- topic and every resource the compound string is built from
+------------------------------------------------------------------------------*/
+static unsigned long _hashBody( XscTextBody body )
+{
+   unsigned long hash = 5381;
+   const char*   ptr;
+
+   for (ptr = body->str; ptr && *ptr; ptr++)
+   {
+      hash = hash * 33 + (unsigned char) *ptr;
+   }
+   for (ptr = body->fontListTag; ptr && *ptr; ptr++)
+   {
+      hash = hash * 33 + (unsigned char) *ptr;
+   }
+   hash = hash * 33 + (unsigned long) body->fontList;
+   hash = hash * 33 + body->alignment;
+   hash = hash * 33 + body->direction;
+   hash = hash * 33 + body->converter;
+   hash = hash * 33 + body->showName;
+
+   return hash ^ (hash >> 16);
+}
+
+static Boolean _equalBodies( XscTextBody a, XscTextBody b )
+{
+   if ((a->fontList  != b->fontList ) ||
+       (a->alignment != b->alignment) ||
+       (a->direction != b->direction) ||
+       (a->converter != b->converter) ||
+       (a->showName  != b->showName ))
+   {
+      return False;
+   }
+
+   if ((a->str != b->str) && 
+       (!a->str || !b->str || strcmp( a->str, b->str )))
+   {
+      return False;
+   }
+
+   if ((a->fontListTag != b->fontListTag) && 
+       (!a->fontListTag || !b->fontListTag || 
+        strcmp( a->fontListTag, b->fontListTag )))
+   {
+      return False;
+   }
+   return True;
+}
+
+
+/*------------------------------------------------------------------------------
+-- These functions maintain the segment table of the converters.  Joining
+-- the segments pairwise, level by level, copies each segment about
+-- log2(n) times; appending them one by one would copy the growing
+-- result n times.
+------------------------------------------------------------------------------*/
+static void _initSegments( XscTextSegmentTableRec* table )
+{
+   table->segments = table->local;
+   table->count    = 0;
+   table->size     = XscTextLocalSegments;
+}
+
+static void _appendSegment( XscTextSegmentTableRec* table, XmString cs )
+{
+   if (table->count == table->size)
+   {
+      XmString* segments = (XmString*) XtMalloc( 
+         sizeof( XmString ) * table->size * 2 );
+
+      memcpy( 
+         (char*) segments, 
+         (char*) table->segments, 
+         sizeof( XmString ) * table->count );
+
+      if (table->segments != table->local)
+      {
+         XtFree( (char*) table->segments );
+      }
+      table->segments = segments;
+      table->size    *= 2;
+   }
+   table->segments[ table->count++ ] = cs;
+}
+
+static XmString _joinSegments( XscTextSegmentTableRec* table )
+{
+   XmString  cs = NULL;
+   XmString* segments = table->segments;
+   Cardinal  count    = table->count;
+
+   while (count > 1)
+   {
+      Cardinal i, joined = 0;
+
+      for (i = 0; i + 1 < count; i += 2)
+      {
+         XmString pair = XmStringConcat( segments[ i ], segments[ i + 1 ] );
+
+         XmStringFree( segments[ i ] );
+         XmStringFree( segments[ i + 1 ] );
+         segments[ joined++ ] = pair;
+      }
+      if (i < count)
+      {
+         segments[ joined++ ] = segments[ i ];
+      }
+      count = joined;
+   }
+
+   if (count == 1)
+   {
+      cs = segments[ 0 ];
+   }
+
+   if (table->segments != table->local)
+   {
+      XtFree( (char*) table->segments );
+   }
+   table->segments = table->local;
+   table->count    = 0;
+
+   return cs;
+}
+
+
+/*------------------------------------------------------------------------------
+-- This function drops the compound string.  It is rebuilt for the given
+-- widget when it is next needed.
+------------------------------------------------------------------------------*/
+void _XscTextMarkDirty( XscText self, Widget w )
+{
+   _unshare( self );
+
+   if (self->body->cs)
+   {
+      XmStringFree( self->body->cs );
+      self->body->cs = NULL;
+   }
+   self->body->dirty  = True;
+   self->body->serial = ++_lastSerial;
+   self->widget       = w;
+
+   _intern( self );
+}
+
+
 /*------------------------------------------------------------------------------
 -- These functions are used to retrieve values
 ------------------------------------------------------------------------------*/
-unsigned char _XscTextGetAlignment  ( XscText self ){return self->alignment  ;}
-unsigned char _XscTextGetConverter  ( XscText self ){return self->converter  ;}
-unsigned char _XscTextGetDirection  ( XscText self ){return self->direction  ;}
-XmFontList    _XscTextGetFontList   ( XscText self ){return self->fontList   ;}
-const char*   _XscTextGetFontListTag( XscText self ){return self->fontListTag;}
-const char*   _XscTextGetTopic      ( XscText self ){return self->str        ;}
+unsigned char _XscTextGetAlignment  ( XscText self ){return self->body->alignment  ;}
+unsigned char _XscTextGetConverter  ( XscText self ){return self->body->converter  ;}
+unsigned char _XscTextGetDirection  ( XscText self ){return self->body->direction  ;}
+XmFontList    _XscTextGetFontList   ( XscText self ){return self->body->fontList   ;}
+const char*   _XscTextGetFontListTag( XscText self ){return self->body->fontListTag;}
+const char*   _XscTextGetTopic      ( XscText self ){return self->body->str        ;}
+
+unsigned long _XscTextGetSerial( XscText self ){return self->body->serial;}
 
 Dimension _XscTextGetHeight( XscText self )
 {
-   Dimension _height = (int) (self->textName ? self->textName->height + 5 : 0);
-   return self->height + _height;
+   Dimension _height;
+
+   _ensureCompoundString( self );
+
+   _height = (int) (self->body->textName ? self->body->textName->height + 5 : 0);
+   return self->body->height + _height;
 }
 Dimension _XscTextGetWidth( XscText self )
 {
-   Dimension _width = (int) (self->textName ? self->textName->width : 0);
-   if (self->width > _width) _width = self->width;
+   Dimension _width;
+
+   _ensureCompoundString( self );
+
+   _width = (int) (self->body->textName ? self->body->textName->width : 0);
+   if (self->body->width > _width) _width = self->body->width;
    return _width;
 }
 
+Widget _XscTextGetWidget( XscText self ){return self->widget;}
+
 const char* _XscTextGetTextName( XscText self )
 {
-   if (self->textName)
+   if (self->body->textName)
    {
-      return self->textName->name;
+      return self->body->textName->name;
    }
    return NULL;
 }
 
 /*------------------------------------------------------------------------------
--- These functions are used to set values
+-- These functions are used to set values.  The alignment, direction, and
+-- font list are used when the text is drawn, so changing one of them 
+-- changes the serial even if the compound string is not rebuilt.
 ------------------------------------------------------------------------------*/
-void _XscTextSetAlignment( XscText self,unsigned char c ){self->alignment = c;}
-void _XscTextSetConverter( XscText self,unsigned char c ){self->converter = c;}
-void _XscTextSetDirection( XscText self,unsigned char c ){self->direction = c;}
-void _XscTextSetFontList ( XscText self,XmFontList    f ){self->fontList  = f;}
+void _XscTextSetAlignment( XscText self, unsigned char c )
+{
+   _unshare( self );
+   self->body->serial = ++_lastSerial;
+   self->body->alignment = c;
+}
+void _XscTextSetConverter( XscText self, unsigned char c )
+{
+   _unshare( self );
+   self->body->converter = c;
+}
+void _XscTextSetDirection( XscText self, unsigned char c )
+{
+   _unshare( self );
+   self->body->serial = ++_lastSerial;
+   self->body->direction = c;
+}
+void _XscTextSetFontList( XscText self, XmFontList f )
+{
+   _unshare( self );
+   self->body->serial = ++_lastSerial;
+   self->body->fontList = f;
+}
 
 void _XscTextSetFontListTag( XscText self, String s )
 {
-   XtFree( self->fontListTag );
-   self->fontListTag = s;
+   _unshare( self );
+   XtFree( self->body->fontListTag );
+   self->body->fontListTag = s;
 }
 void _XscTextSetTopic( XscText self, String s)
 {
-   XtFree( self->str );
-   self->str = s;
+   _forgetTopic( self );
+   _unshare( self );
+   if (!self->body->mapped) XtFree( self->body->str );
+   self->body->str    = s;
+   self->body->mapped = False;
 }
 
 /*------------------------------------------------------------------------------
@@ -550,38 +986,33 @@ void _XscTextLoadResources(
    XtResource* resource, 
    Cardinal    res_count )
 {
-   XtFree( self->fontListTag );
-   XtFree( self->str         );
-   
-   if (self->cs) 
-   {
-      XmStringFree( self->cs );
-      self->cs = NULL;
-   }
-   
-   memset( (char*) self, '\0', sizeof( *self ) );
+   _forgetTopic( self );
+   _releaseBody( self->display, self->body );
+
+   self->body   = _createBody( self->display );
+   self->widget = NULL;
       
-   XtGetApplicationResources( w, self, resource, res_count, NULL, (Cardinal)0 );
+   _XscResourceGetValues( w, (XtPointer) self->body, resource, res_count );
    
    /*----------------------------------------------------------------
    -- Use the default topic string none where found in the database
    ----------------------------------------------------------------*/
-   if (!self->str)
+   if (!self->body->str)
    {
-      self->str = (String) def;
+      self->body->str = (String) def;
    }
    
-   if (self->fontListTag)
+   if (self->body->fontListTag)
    {
-      self->fontListTag = XtNewString( self->fontListTag );
+      self->body->fontListTag = XtNewString( self->body->fontListTag );
    }
    
-   if (self->str)
+   if (self->body->str)
    {
       /*----------------------------------------
       -- Check and see if this is a reference
       ----------------------------------------*/
-      if (*self->str == '.')
+      if (*self->body->str == '.')
       {
 	 static XrmName  QUARK_NameList[ 4 ] = 
 	    { NULLQUARK, NULLQUARK, NULLQUARK, NULLQUARK };
@@ -596,6 +1027,7 @@ void _XscTextLoadResources(
 	 XrmValue          _value;
 	 char*             _str;
 	 char*             _ptr;
+	 String            _topic;
 	 int               _len;
 	 
       	 if (QUARK_String == NULLQUARK)
@@ -608,7 +1040,7 @@ void _XscTextLoadResources(
 	    QUARK_NameList [ 1 ] = XrmPermStringToQuark( "topic" );
 	    QUARK_ClassList[ 1 ] = XrmPermStringToQuark( "Topic" );
 	 }
-      	 _str = XtNewString( (self->str) + 1 );
+      	 _str = XtNewString( (self->body->str) + 1 );
 	 _len = strlen( _str );
 	 if (_len)
 	 {
@@ -628,33 +1060,58 @@ void _XscTextLoadResources(
 	 QUARK_ClassList[ 2 ] = QUARK_NameList[ 2 ];
 	 XtFree( _str );
 	 
-	 _result = XrmQGetResource(
-	    XrmGetDatabase( XtDisplayOfObject( w ) ),
-	    QUARK_NameList,
-	    QUARK_ClassList,
-	    &_type,
-	    &_value );
-	 
-	 if (_result && _type == QUARK_String)
+	 /*----------------------------------------------------------------
+	 -- Topics loaded from topic files are in a table of their own.
+	 -- Topics may still be given as resources, so the resource
+	 -- database is searched for the ones that are not in the table.
+	 -- The reference is recorded even if the topic is not found, so
+	 -- a topic file that defines it later updates this text.  The
+	 -- text of a catalog topic is used where it is mapped, since
+	 -- the catalog stays mapped as long as the table exists.
+	 ----------------------------------------------------------------*/
+	 self->topic = QUARK_NameList[ 2 ];
+	 _XscTopicTableAddReference( 
+	    _XscDisplayGetTopics( self->display ), self->topic, 
+	    (XtPointer) self );
+
+	 _topic = _XscTopicTableGet( 
+	    _XscDisplayGetTopics( self->display ), QUARK_NameList[ 2 ], 
+	    &self->body->mapped );
+
+	 if (_topic)
 	 {
-	    self->str = XtNewString( _value.addr );
+	    self->body->str = self->body->mapped ? _topic : XtNewString( _topic );
 	 }
 	 else
 	 {
-	    self->str = XtNewString( self->str );
+	    _result = XrmQGetResource(
+	       XrmGetDatabase( XtDisplayOfObject( w ) ),
+	       QUARK_NameList,
+	       QUARK_ClassList,
+	       &_type,
+	       &_value );
+	    
+	    if (_result && _type == QUARK_String)
+	    {
+	       self->body->str = XtNewString( _value.addr );
+	    }
+	    else
+	    {
+	       self->body->str = XtNewString( self->body->str );
+	    }
 	 }
       }
       else
       {
-      	 self->str = XtNewString( self->str );
+      	 self->body->str = XtNewString( self->body->str );
       }
    }
-   _XscTextCreateCompoundString( self, w );
+   _XscTextMarkDirty( self, w );
 }
 
 void _XscTextLoadCueResources( XscText self, Widget w, const char* def )
 {
-#  define OFFSET_OF( mem ) XtOffsetOf( XscTextRec, mem )
+#  define OFFSET_OF( mem ) XtOffsetOf( XscTextBodyRec, mem )
 
    static XtResource resource[] =
    {
@@ -696,7 +1153,7 @@ void _XscTextLoadCueResources( XscText self, Widget w, const char* def )
 
 void _XscTextLoadHintResources( XscText self, Widget w, const char* def )
 {
-#  define OFFSET_OF( mem ) XtOffsetOf( XscTextRec, mem )
+#  define OFFSET_OF( mem ) XtOffsetOf( XscTextBodyRec, mem )
 
    static XtResource resource[] =
    {
@@ -738,7 +1195,7 @@ void _XscTextLoadHintResources( XscText self, Widget w, const char* def )
 
 void _XscTextLoadTipResources( XscText self, Widget w, const char* def )
 {
-#  define OFFSET_OF( mem ) XtOffsetOf( XscTextRec, mem )
+#  define OFFSET_OF( mem ) XtOffsetOf( XscTextBodyRec, mem )
 
    static XtResource resource[] =
    {
@@ -794,27 +1251,29 @@ void _XscTextStringDraw(
    Pixel       foreground,
    Boolean     selected )
 {   
+   _ensureCompoundString( self );
+
    if (width == 0) width = _XscTextGetWidth( self );
  
    XSetForeground( x_display, gc, foreground );
    
-   if (self->cs)
+   if (self->body->cs)
    {  
       XmStringDraw( 
 	 x_display,
 	 window,
-	 self->fontList,
-	 self->cs,
+	 self->body->fontList,
+	 self->body->cs,
 	 gc, 
 	 x, 
 	 y, 
 	 width, 
-	 self->alignment, 
-	 self->direction, 
+	 self->body->alignment, 
+	 self->body->direction, 
 	 clip );
    }
 
-   if (self->textName && self->textName->cs)
+   if (self->body->textName && self->body->textName->cs)
    {  
       if (selected)
       {
@@ -824,14 +1283,14 @@ void _XscTextStringDraw(
 	 XmStringDrawImage( 
 	    x_display,
 	    window,
-	    self->fontList,
-	    self->textName->cs,
+	    self->body->fontList,
+	    self->body->textName->cs,
 	    gc, 
 	    x, 
-	    y + self->height + 5, 
+	    y + self->body->height + 5, 
 	    width, 
-	    self->alignment, 
-	    self->direction, 
+	    self->body->alignment, 
+	    self->body->direction, 
 	    clip );
       }
       else
@@ -839,14 +1298,14 @@ void _XscTextStringDraw(
 	 XmStringDraw( 
 	    x_display,
 	    window,
-	    self->fontList,
-	    self->textName->cs,
+	    self->body->fontList,
+	    self->body->textName->cs,
 	    gc, 
 	    x, 
-	    y + self->height + 5, 
+	    y + self->body->height + 5, 
 	    width, 
-	    self->alignment, 
-	    self->direction, 
+	    self->body->alignment, 
+	    self->body->direction, 
 	    clip );
       }
    }
@@ -858,10 +1317,32 @@ void _XscTextStringDraw(
 ------------------------------------------------------------------------------*/
 Boolean _XscTextStringExists( XscText self )
 {
-   return (self && (self->cs || (self->showName != XmXSC_SHOW_NAME_NONE)));
+   Boolean exists;
+
+   if (!self) return False;
+
+   /*------------------------------------------------------------------
+   -- This is asked when a widget is installed, so it must not force
+   -- the conversion.  The standard converter always makes a string;
+   -- the others only make one if there is at least one character.
+   ------------------------------------------------------------------*/
+   if (self->body->dirty)
+   {
+      exists = self->body->str && 
+         ((self->body->converter == XmXSC_STRING_CONVERTER_STANDARD) || *self->body->str);
+   }
+   else
+   {
+      exists = (self->body->cs != NULL);
+   }
+   return exists || (self->body->showName != XmXSC_SHOW_NAME_NONE);
 }
 
 Boolean _XscTextHasWidgetName( XscText self )
 {
-   return (self && self->textName && self->textName->cs);
+   if (!self) return False;
+
+   _ensureCompoundString( self );
+
+   return (self->body->textName && self->body->textName->cs);
 }
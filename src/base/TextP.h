@@ -18,12 +18,14 @@
 /*==============================================================================
                                    Handle
 ==============================================================================*/
-typedef struct _XscTextRec *XscText;
+typedef struct _XscTextRec      *XscText;
+typedef struct _XscTextTableRec *XscTextTable;
 
 
 /*==============================================================================
                               Private Includes
 ==============================================================================*/
+#include "DisplayP.h"
 
 
 #ifdef __cplusplus
@@ -44,14 +46,18 @@ extern "C" {
 /*==============================================================================
                                   Prototypes
 ==============================================================================*/
-XscText _XscTextCreate();
+XscText _XscTextCreate( XscDisplay );
 
 void _XscTextDestroy( XscText );
 
+XscTextTable _XscTextTableCreate ( void );
+void         _XscTextTableDestroy( XscTextTable );
+
 void _XscTextConvertSegmented    ( XscText, Widget );
 void _XscTextConvertFontTag      ( XscText, Widget );
 void _XscTextConvertStandard     ( XscText, Widget );
 void _XscTextCreateCompoundString( XscText, Widget );
+void _XscTextMarkDirty           ( XscText, Widget );
 
 unsigned char _XscTextGetAlignment  ( XscText );
 unsigned char _XscTextGetConverter  ( XscText );
@@ -59,9 +65,11 @@ unsigned char _XscTextGetDirection  ( XscText );
 XmFontList    _XscTextGetFontList   ( XscText );
 const char*   _XscTextGetFontListTag( XscText );
 Dimension     _XscTextGetHeight     ( XscText );
+unsigned long _XscTextGetSerial     ( XscText );
 const char*   _XscTextGetTextName   ( XscText );
 const char*   _XscTextGetTopic      ( XscText );
 Dimension     _XscTextGetWidth      ( XscText );
+Widget        _XscTextGetWidget     ( XscText );
 
 void _XscTextSetAlignment  ( XscText, unsigned char );
 void _XscTextSetConverter  ( XscText, unsigned char );
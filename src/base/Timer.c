@@ -0,0 +1,325 @@
+/*------------------------------------------------------------------------------
+--  Help ToolKit for Motif
+--
+--  (c) Copyright 1997-1999, 2019 Robert S. Werner (a.k.a. Akiva Werner)
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+------------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <X11/Intrinsic.h>
+
+#include "TimerP.h"
+
+/*==============================================================================
+                               Private data types
+==============================================================================*/
+/*-------------------------------------------------------------------------
+-- The pending entries are kept in a binary heap ordered by deadline.  A
+-- single Xt timeout is armed for the earliest of them.  It is only
+-- replaced when an entry is due sooner than the time it is armed for;
+-- when it fires too early it is simply armed again for what is left.
+-------------------------------------------------------------------------*/
+typedef struct _XscTimerRec
+{
+   XtAppContext   appContext;
+   XscTimerEntry* heap;
+   Cardinal       count;
+   Cardinal       size;
+   XtIntervalId   timeOut;
+   unsigned long  armedDeadline;   /* When timeOut fires */
+}
+XscTimerRec;
+
+
+/*==============================================================================
+                               Private prototypes
+==============================================================================*/
+static void          _arm     ( XscTimer );
+static Boolean       _before  ( unsigned long, unsigned long );
+static void          _expireTO( XtPointer, XtIntervalId* );
+static unsigned long _now     ( void );
+static void          _remove  ( XscTimer, Cardinal );
+static void          _siftDown( XscTimer, Cardinal );
+static void          _siftUp  ( XscTimer, Cardinal );
+
+
+/*==============================================================================
+                               Protected functions
+==============================================================================*/
+
+/*----------------------------------------------------------------------------
+-- This function creates an empty scheduler
+------------------------------------------------------------------------------*/
+XscTimer _XscTimerCreate( XtAppContext app_context )
+{
+   XscTimer self = XtNew( XscTimerRec );
+
+   memset( (char*) self, '\0', sizeof( *self ) );
+   self->appContext = app_context;
+   self->timeOut    = (XtIntervalId) NULL;
+
+   return self;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function releases the scheduler.  Pending entries are dropped.
+------------------------------------------------------------------------------*/
+void _XscTimerDestroy( XscTimer self )
+{
+   Cardinal i;
+
+   for (i = 0; i < self->count; i++)
+   {
+      self->heap[ i ]->index = XscTimerNotPending;
+   }
+
+   if (self->timeOut)
+   {
+      XtRemoveTimeOut( self->timeOut );
+   }
+   XtFree( (char*) self->heap );
+   XtFree( (char*) self );
+}
+
+
+/*----------------------------------------------------------------------------
+-- These functions set up an entry and tell if it is scheduled
+------------------------------------------------------------------------------*/
+void _XscTimerInitEntry( XscTimerEntry entry )
+{
+   entry->deadline = 0;
+   entry->index    = XscTimerNotPending;
+   entry->proc     = NULL;
+   entry->data     = NULL;
+}
+
+Boolean _XscTimerIsPending( XscTimerEntry entry )
+{
+   return entry->index != XscTimerNotPending;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function takes an entry off the schedule, if it is on it
+------------------------------------------------------------------------------*/
+void _XscTimerCancel( XscTimer self, XscTimerEntry entry )
+{
+   if (entry->index != XscTimerNotPending)
+   {
+      _remove( self, entry->index );
+   }
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function (re)schedules an entry to call 'proc' after 'interval'
+-- milliseconds
+------------------------------------------------------------------------------*/
+void _XscTimerStart(
+   XscTimer      self,
+   XscTimerEntry entry,
+   unsigned long interval,
+   XscTimerProc  proc,
+   XtPointer     data )
+{
+   entry->deadline = _now() + interval;
+   entry->proc     = proc;
+   entry->data     = data;
+
+   if (entry->index == XscTimerNotPending)
+   {
+      if (self->count == self->size)
+      {
+         self->size = self->size ? self->size * 2 : 8;
+         self->heap = (XscTimerEntry*) XtRealloc(
+            (char*) self->heap, sizeof( XscTimerEntry ) * self->size );
+      }
+      entry->index = self->count++;
+      self->heap[ entry->index ] = entry;
+   }
+
+   /*-----------------------------------------------------------
+   -- The deadline may have moved either way; only one of these
+   -- does anything
+   -----------------------------------------------------------*/
+   _siftUp  ( self, entry->index );
+   _siftDown( self, entry->index );
+
+   _arm( self );
+}
+
+
+
+/*==============================================================================
+                               Private functions
+==============================================================================*/
+
+/*----------------------------------------------------------------------------
+-- This function makes sure the Xt timeout fires no later than the earliest
+-- deadline
+------------------------------------------------------------------------------*/
+static void _arm( XscTimer self )
+{
+   unsigned long deadline;
+   unsigned long now;
+
+   if (self->count == 0)
+   {
+      return;
+   }
+
+   deadline = self->heap[ 0 ]->deadline;
+
+   if (self->timeOut)
+   {
+      if (!_before( deadline, self->armedDeadline ))
+      {
+         return;
+      }
+      XtRemoveTimeOut( self->timeOut );
+   }
+
+   now = _now();
+   self->armedDeadline = deadline;
+   self->timeOut = XtAppAddTimeOut(
+      self->appContext,
+      _before( now, deadline ) ? deadline - now : 0,
+      _expireTO,
+      (XtPointer) self );
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function compares two deadlines, allowing for the clock to wrap
+------------------------------------------------------------------------------*/
+static Boolean _before( unsigned long a, unsigned long b )
+{
+   return (long) (a - b) < 0;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This timer calls the procedures of the entries that are due
+------------------------------------------------------------------------------*/
+static void _expireTO( XtPointer cd, XtIntervalId* not_used )
+{
+   XscTimer self = (XscTimer) cd;
+
+   self->timeOut = (XtIntervalId) NULL;
+
+   /*--------------------------------------------------------------------
+   -- An entry is taken off the heap before its procedure is called, so
+   -- the procedure is free to schedule or cancel any entry
+   --------------------------------------------------------------------*/
+   while (self->count && !_before( _now(), self->heap[ 0 ]->deadline ))
+   {
+      XscTimerEntry entry = self->heap[ 0 ];
+
+      _remove( self, 0 );
+      (*entry->proc)( entry->data );
+   }
+
+   _arm( self );
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function returns a millisecond clock
+------------------------------------------------------------------------------*/
+static unsigned long _now( void )
+{
+   struct timeval tv;
+
+   gettimeofday( &tv, NULL );
+
+   return (unsigned long) tv.tv_sec * 1000 + tv.tv_usec / 1000;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function takes the entry at a heap position off the heap
+------------------------------------------------------------------------------*/
+static void _remove( XscTimer self, Cardinal index )
+{
+   XscTimerEntry entry = self->heap[ index ];
+
+   assert( index < self->count );
+
+   self->count -= 1;
+   if (index < self->count)
+   {
+      XscTimerEntry last = self->heap[ self->count ];
+
+      /*-----------------------------------------------------
+      -- The last entry fills the hole and is moved to where
+      -- it belongs
+      -----------------------------------------------------*/
+      self->heap[ index ] = last;
+      last->index = index;
+
+      _siftUp  ( self, index );
+      _siftDown( self, last->index );
+   }
+   entry->index = XscTimerNotPending;
+}
+
+
+/*----------------------------------------------------------------------------
+-- These functions restore the heap order around one position
+------------------------------------------------------------------------------*/
+static void _siftUp( XscTimer self, Cardinal index )
+{
+   XscTimerEntry entry = self->heap[ index ];
+
+   while (index > 0)
+   {
+      Cardinal parent = (index - 1) / 2;
+
+      if (!_before( entry->deadline, self->heap[ parent ]->deadline ))
+      {
+         break;
+      }
+      self->heap[ index ] = self->heap[ parent ];
+      self->heap[ index ]->index = index;
+      index = parent;
+   }
+   self->heap[ index ] = entry;
+   entry->index = index;
+}
+
+static void _siftDown( XscTimer self, Cardinal index )
+{
+   XscTimerEntry entry = self->heap[ index ];
+
+   for (;;)
+   {
+      Cardinal child = index * 2 + 1;
+
+      if (child >= self->count)
+      {
+         break;
+      }
+      if ((child + 1 < self->count) &&
+          _before( self->heap[ child + 1 ]->deadline,
+                   self->heap[ child ]->deadline ))
+      {
+         child += 1;
+      }
+      if (!_before( self->heap[ child ]->deadline, entry->deadline ))
+      {
+         break;
+      }
+      self->heap[ index ] = self->heap[ child ];
+      self->heap[ index ]->index = index;
+      index = child;
+   }
+   self->heap[ index ] = entry;
+   entry->index = index;
+}
@@ -0,0 +1,79 @@
+/*------------------------------------------------------------------------------
+--  Help ToolKit for Motif
+--
+--  (c) Copyright 1997-1999, 2019 Robert S. Werner (a.k.a. Akiva Werner)
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+------------------------------------------------------------------------------*/
+
+#ifndef __XscTimerP_h
+#define __XscTimerP_h
+
+
+#include <X11/Intrinsic.h>
+
+
+/*==============================================================================
+                                   Handle
+==============================================================================*/
+typedef struct _XscTimerRec *XscTimer;
+
+
+/*==============================================================================
+                              Private Includes
+==============================================================================*/
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+                                    Macros
+==============================================================================*/
+/*---------------------------------------------------------------------
+-- The heap index of an entry that is not scheduled
+---------------------------------------------------------------------*/
+#define XscTimerNotPending ((Cardinal) ~0)
+
+
+/*==============================================================================
+                               Data types
+==============================================================================*/
+typedef void (*XscTimerProc)( XtPointer );
+
+/*---------------------------------------------------------------------
+-- A timer entry is kept in the record it belongs to, so scheduling
+-- it again only moves it within the heap.  Entries must be set up
+-- with _XscTimerInitEntry() before they are used.
+---------------------------------------------------------------------*/
+typedef struct _XscTimerEntryRec
+{
+   unsigned long deadline;      /* In milliseconds */
+   Cardinal      index;         /* Position in the heap */
+   XscTimerProc  proc;
+   XtPointer     data;
+}
+XscTimerEntryRec, *XscTimerEntry;
+
+
+/*==============================================================================
+                                  Prototypes
+==============================================================================*/
+XscTimer _XscTimerCreate ( XtAppContext );
+void     _XscTimerDestroy( XscTimer );
+
+void    _XscTimerInitEntry( XscTimerEntry );
+Boolean _XscTimerIsPending( XscTimerEntry );
+
+void _XscTimerCancel( XscTimer, XscTimerEntry );
+void _XscTimerStart ( XscTimer, XscTimerEntry, unsigned long, XscTimerProc,
+                      XtPointer );
+
+
+#ifdef __cplusplus
+}  /* Close scope of 'extern "C"' declaration which encloses file. */
+#endif
+
+#endif
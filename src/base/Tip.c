@@ -21,6 +21,8 @@
 
 #include "DisplayP.h"
 #include "ObjectP.h"
+#include "ResourceP.h"
+#include "ScreenP.h"
 #include "ShellP.h"
 #include "TextP.h"
 #include "TipP.h"
@@ -60,6 +62,7 @@ typedef struct _XscTipRec
    unsigned char shadowType;
    unsigned char position;          /* Tip layout policy */
    Boolean       autoDbReload;
+   unsigned long dbGeneration;      /* When the resources were loaded */
    Boolean       enabled;
    Boolean       motifColorModel;
    Boolean       compound;
@@ -71,6 +74,7 @@ typedef struct _XscTipRec
    int           _rootX;         /* Used to compute the X,Y offset when */
    int           _rootY;         /* in pointer mode --------------------*/
    Boolean       _selected;
+   XscScreenColorsRec _colors;   /* Derived from the background */
 }
 XscTipRec;
 
@@ -178,11 +182,29 @@ static void _tipLoseNameSelectionCB( Widget w, Atom* selection )
 }
 
 
+/*------------------------------------------------------------------------------
+-- This function makes sure the derived colors match the current color
+-- attributes.  The screen keeps what XmGetColors returned, so this is only
+-- a lookup after the first time.
+------------------------------------------------------------------------------*/
+static void _resolveColors( XscTip self )
+{
+   XscScreen screen = _XscObjectGetScreen( self->object );
+   Widget    frame  = _XscScreenGetTipFrame( screen );
+
+   _XscScreenGetColors(
+      screen,
+      frame->core.colormap,
+      self->motifColorModel ? self->background : self->colorBase,
+      &self->_colors );
+}
+
+
 XscTip _XscTipCreate( XscObject o )
 {
-   XscTip self = XtNew( XscTipRec );
+   XscTip self = (XscTip) _XscDisplayAllocRecord( 
+      _XscObjectGetDisplay( o ), XmXSC_POOL_TIP, sizeof( XscTipRec ) );
    
-   memset( (void*) self, '\0', sizeof( *self ) );
    self->text   = NULL;
    self->object = o;
 
@@ -192,7 +214,8 @@ XscTip _XscTipCreate( XscObject o )
 void _XscTipDestroy( XscTip self )
 {
    if (self->text) _XscTextDestroy( self->text );
-   XtFree( (char*) self );
+   _XscDisplayFreeRecord( 
+      _XscObjectGetDisplay( self->object ), XmXSC_POOL_TIP, (XtPointer) self );
 }
 
 
@@ -314,11 +337,11 @@ void _XscTipLoadResources( XscTip self, XscText text )
 
    Widget w = _XscObjectGetWidget( self->object );
    
-   XtGetApplicationResources( 
-      w,
-      self, 
-      resource,   (Cardinal) XtNumber( resource ),
-      NULL,       (Cardinal) 0 );
+   _XscResourceGetValues( 
+      w, (XtPointer) self, resource, (Cardinal) XtNumber( resource ) );
+   
+   self->dbGeneration = 
+      _XscDisplayGetDbGeneration( _XscObjectGetDisplay( self->object ) );
    
    if (text)
    {
@@ -335,10 +358,12 @@ void _XscTipLoadResources( XscTip self, XscText text )
    {
       if (self->text == NULL)
       {
-         self->text = _XscTextCreate();
+         self->text = 
+            _XscTextCreate( _XscObjectGetDisplay( self->object ) );
       }
       _XscTextLoadTipResources( self->text, w, NULL );
    }
+   _resolveColors( self );
    
    if (self->yOffset == XscHelpDefaultTipYOffsetDynamic)
    {
@@ -361,10 +386,8 @@ void _XscTipActivate( XscTip self )
    XscDisplay htk_display;
    XscShell   htk_shell;
    int        tip_group_id;
-   Widget     w;
    
-   w = _XscObjectGetWidget( self->object );
-   htk_display = _XscDisplayDeriveFromWidget( w );
+   htk_display = _XscObjectGetDisplay( self->object );
 
    /*----------------------------------------------------
    -- This object is now the active tip on this display
@@ -373,16 +396,18 @@ void _XscTipActivate( XscTip self )
 
    /*--------------------------------------------------------------
    -- If the tip needs to be dynamically updated, then reload its
-   -- attributes from the resource database
+   -- attributes once the resource database has changed
    --------------------------------------------------------------*/
-   if (self->autoDbReload)
+   if (self->autoDbReload && 
+       (self->dbGeneration != _XscDisplayGetDbGeneration( htk_display )))
    {
+      _XscDisplayIncrementCounter( htk_display, XmXSC_COUNTER_DB_RELOADS );
       _XscTipLoadResources( self, NULL );
    }
 
    tip_group_id = XscTipGetGroupId( self );
    
-   htk_shell = _XscShellDeriveFromWidget( w );
+   htk_shell = _XscObjectGetShell( self->object );
    
    /*------------------------------------------------------
    -- Don't bother to go any further unless it is managed
@@ -427,18 +452,16 @@ void _XscTipUpdate( XscTip self )
    XscDisplay htk_display;
    XscScreen    htk_screen;
    int           text_height, text_width, popup_height, popup_width;
-   Pixel         foreground_color, select_color;
-   Pixel         top_shadow_color, bottom_shadow_color;
    Widget        object_widget;
    int           tip_group_id;
    int           y_offset = self->yOffset;
    
    object_widget = _XscObjectGetWidget( self->object );
-   htk_screen = _XscScreenDeriveFromWidget( object_widget );
+   htk_screen = _XscObjectGetScreen( self->object );
    assert( htk_screen );
    screen = XtScreenOfObject( object_widget );
 
-   htk_display = _XscDisplayDeriveFromWidget( object_widget );
+   htk_display = _XscObjectGetDisplay( self->object );
    tip_group_id = XscTipGetGroupId( self );
    
    _XscDisplaySetTipActiveGroupId( htk_display, tip_group_id );
@@ -635,69 +658,26 @@ void _XscTipUpdate( XscTip self )
    }
 
    {
-      Widget tip_shell, tip_frame, tip_label;
-
-      tip_shell = _XscScreenGetTipShell( htk_screen );
-      tip_frame = _XscScreenGetTipFrame( htk_screen );
-      tip_label = _XscScreenGetTipLabel( htk_screen );
-
-      /*--------------------------------------------------------
-      -- Assign the height and width to the tip display widget
-      --------------------------------------------------------*/
-      XtVaSetValues(
-         tip_label,
-         XtNbackground, self->background,
-         XtNwidth,      (Dimension) text_width,
-         XtNheight,     (Dimension) text_height,
-         NULL );
+      XscScreenLayoutRec layout;
 
       /*-----------------------------------------------------
       -- Determine the colors to use for the shadow borders
       -----------------------------------------------------*/
-      if (self->motifColorModel)
-      {
-         XmGetColors(
-            screen,
-            tip_frame->core.colormap,
-            self->background,
-            &foreground_color,
-            &top_shadow_color,
-            &bottom_shadow_color,
-            &select_color );
-      }
-      else
-      {
-         XmGetColors(
-            screen,
-            tip_frame->core.colormap,
-            self->colorBase,
-            &foreground_color,
-            &top_shadow_color,
-            &bottom_shadow_color,
-            &select_color );
-      }
-
-      /*---------------------------------------
-      -- Specify the shadow border attributes
-      ---------------------------------------*/
-      XtVaSetValues(
-         tip_frame,
-         XmNshadowThickness,    self->shadowThickness,
-         XmNshadowType,         self->shadowType,
-         XmNtopShadowColor,     top_shadow_color,
-         XmNbottomShadowColor,  bottom_shadow_color,
-         NULL );
-
-      /*---------------------------------------
-      -- Specify the window border attributes
-      ---------------------------------------*/
-      XtVaSetValues(
-         tip_shell, 
-         XtNx,		(Position) popup_x,
-         XtNy,		(Position) popup_y,
-         XtNborderWidth,self->borderWidth,
-         XtNborderColor,self->borderColor,
-         NULL );
+      _resolveColors( self );
+
+      layout.x               = (Position) popup_x;
+      layout.y               = (Position) popup_y;
+      layout.borderWidth     = self->borderWidth;
+      layout.borderColor     = self->borderColor;
+      layout.shadowThickness = self->shadowThickness;
+      layout.shadowType      = self->shadowType;
+      layout.topShadow       = self->_colors.topShadow;
+      layout.bottomShadow    = self->_colors.bottomShadow;
+      layout.width           = (Dimension) text_width;
+      layout.height          = (Dimension) text_height;
+      layout.background      = self->background;
+
+      _XscScreenLayoutTip( htk_screen, &layout );
    }         
 }
 
@@ -706,9 +686,8 @@ void _XscTipUpdate( XscTip self )
 ------------------------------------------------------------------------------*/
 void _XscTipPopdown( XscTip self )
 {
-   Widget     object_widget = _XscObjectGetWidget( self->object );
-   XscDisplay xsc_display   = _XscDisplayDeriveFromWidget( object_widget );
-   XscScreen  xsc_screen    = _XscScreenDeriveFromWidget ( object_widget );
+   XscDisplay xsc_display   = _XscObjectGetDisplay( self->object );
+   XscScreen  xsc_screen    = _XscObjectGetScreen ( self->object );
    
    /*-----------------------------------------------------------------------
    -- Verify that this object is the object recorded in the display record
@@ -736,8 +715,8 @@ void _XscTipPopdown( XscTip self )
 void _XscTipPopup( XscTip self )
 {
    Widget object_widget = _XscObjectGetWidget( self->object );
-   XscDisplay htk_display = _XscDisplayDeriveFromWidget( object_widget );
-   XscScreen htk_screen = _XscScreenDeriveFromWidget( object_widget );
+   XscDisplay htk_display = _XscObjectGetDisplay( self->object );
+   XscScreen htk_screen = _XscObjectGetScreen( self->object );
 
    Bool          bool;
    Window        root_window, child_window;
@@ -748,16 +727,37 @@ void _XscTipPopup( XscTip self )
    assert( htk_screen );
    screen = XtScreenOfObject( object_widget );
 
-   bool = XQueryPointer(
-      XtDisplayOfObject( object_widget ),
-      RootWindowOfScreen( screen ),
-      &root_window,
-      &child_window,
-      &root_x,
-      &root_y,
-      &win_x,
-      &win_y,
-      &keys_buttons );
+   _XscDisplayIncrementCounter( htk_display, XmXSC_COUNTER_TIP_POPUPS );
+
+   /*-----------------------------------------------------------------
+   -- Only pointer placement needs the pointer.  The event that got
+   -- us here normally told where it was, so the server is only asked
+   -- if the pointer was last seen on another screen (or not at all).
+   -----------------------------------------------------------------*/
+   if (self->position != XmXSC_TIP_POSITION_POINTER)
+   {
+      bool = False;
+   }
+   else if (_XscDisplayGetPointer( 
+               htk_display, RootWindowOfScreen( screen ), &root_x, &root_y ))
+   {
+      bool = True;
+   }
+   else
+   {
+      _XscDisplayIncrementCounter( htk_display, XmXSC_COUNTER_POINTER_QUERIES );
+
+      bool = XQueryPointer(
+         XtDisplayOfObject( object_widget ),
+         RootWindowOfScreen( screen ),
+         &root_window,
+         &child_window,
+         &root_x,
+         &root_y,
+         &win_x,
+         &win_y,
+         &keys_buttons );
+   }
 
    if (bool)
    {
@@ -807,8 +807,10 @@ void _XscTipRender( XscTip self, Widget tip_widget, GC gc )
 {
    if (XscTipHasValidTopic( self ))
    {
-      Pixel        foreground_color, select_color;
-      Pixel        top_shadow_color, bottom_shadow_color;
+      Pixel        foreground_color;
+      XscScreenPixmapKeyRec key;
+      Pixmap       pixmap;
+      Boolean      created;
       Display*     display    = XtDisplay( tip_widget );
 
       /*---------------------
@@ -821,42 +823,72 @@ void _XscTipRender( XscTip self, Widget tip_widget, GC gc )
       ---------------------------------------------*/
       if (self->motifColorModel)
       {
-         XmGetColors(
-            XtScreen( tip_widget ),
-            tip_widget->core.parent->core.colormap,
-            self->background,
-            &foreground_color,
-            &top_shadow_color,
-            &bottom_shadow_color,
-            &select_color );
+         _resolveColors( self );
+         foreground_color = self->_colors.foreground;
       }
       else
       {
          foreground_color = self->foreground;
       }
 
-      /*------------------
-      -- Render the text
-      ------------------*/
-      _XscTextStringDraw( 
-         self->text,
-         display,
-         XtWindow( tip_widget ),
-         gc,
-         self->marginWidth  + self->marginLeft, 
-         self->marginHeight + self->marginTop,
-         0,
-         NULL,
-	 self->background,
-	 foreground_color,
-	 self->_selected );
+      /*-------------------------------------------------------------
+      -- The text is rendered into a pixmap kept by the screen, so
+      -- another expose, or showing the same text again, is a copy
+      -------------------------------------------------------------*/
+      key.serial     = _XscTextGetSerial( self->text );
+      key.width      = tip_widget->core.width;
+      key.height     = tip_widget->core.height;
+      key.x          = self->marginWidth  + self->marginLeft;
+      key.y          = self->marginHeight + self->marginTop;
+      key.background = self->background;
+      key.foreground = foreground_color;
+      key.selected   = self->_selected;
+
+      pixmap = _XscScreenGetPixmap( 
+         _XscObjectGetScreen( self->object ), tip_widget, &key, &created );
+
+      if (created)
+      {
+         XSetForeground( display, gc, self->background );
+         XFillRectangle( display, pixmap, gc, 0, 0, key.width, key.height );
+      }
+
+      /*----------------------------------------------------
+      -- Render the text (straight to the window if there
+      -- is no room for it in the cache)
+      ----------------------------------------------------*/
+      if (created || (pixmap == None))
+      {
+         _XscTextStringDraw( 
+            self->text,
+            display,
+            pixmap ? pixmap : XtWindow( tip_widget ),
+            gc,
+            key.x, 
+            key.y,
+            0,
+            NULL,
+            self->background,
+            foreground_color,
+            key.selected );
+      }
+
+      if (pixmap)
+      {
+         XCopyArea( 
+            display, 
+            pixmap, 
+            XtWindow( tip_widget ), 
+            gc, 
+            0, 0, key.width, key.height, 0, 0 );
+      }
    }
 }
 
 void _XscTipSelectName( XscTip self )
 {
    Widget object_widget = _XscObjectGetWidget( self->object );
-   XscScreen htk_screen = _XscScreenDeriveFromWidget( object_widget );
+   XscScreen htk_screen = _XscObjectGetScreen( self->object );
    
    if (!XtIsWidget( object_widget ))
    {
@@ -989,7 +1021,7 @@ void XscTipSetAlignment( XscTip self, unsigned char a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( _XscTipGetObject( self ) );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -999,7 +1031,7 @@ void XscTipSetFontList( XscTip self, XmFontList a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( _XscTipGetObject( self ) );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -1009,7 +1041,7 @@ void XscTipSetFontListTag( XscTip self, String a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( _XscTipGetObject( self ) );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -1040,7 +1072,7 @@ void XscTipSetStringConverter( XscTip self, unsigned char a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( _XscTipGetObject( self ) );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -1050,7 +1082,7 @@ void XscTipSetStringDirection( XscTip self, unsigned char a, Boolean u )
    if (u)                              
    {                                   
       Widget w = _XscObjectGetWidget( _XscTipGetObject( self ) );
-      _XscTextCreateCompoundString( self->text, w );
+      _XscTextMarkDirty( self->text, w );
    }                                   
 }
 
@@ -1059,7 +1091,7 @@ void XscTipSetTopic( XscTip self, String a )
    Widget w = _XscObjectGetWidget( _XscTipGetObject( self ) );
    
    _XscTextSetTopic( self->text, XtNewString( a ) );
-   _XscTextCreateCompoundString( self->text, w );
+   _XscTextMarkDirty( self->text, w );
 }
 
 
@@ -0,0 +1,1129 @@
+/*------------------------------------------------------------------------------
+--  Help ToolKit for Motif
+--
+--  (c) Copyright 1997-1999, 2019 Robert S. Werner (a.k.a. Akiva Werner)
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+------------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#include <X11/Intrinsic.h>
+
+#include "TopicP.h"
+
+/*==============================================================================
+                               Private data types
+==============================================================================*/
+/*-------------------------------------------------------------------------
+-- A topic file that was loaded into a table.  The names of the topics
+-- it defined are kept so a reload can tell which ones it no longer has.
+-------------------------------------------------------------------------*/
+typedef struct _XscTopicFileRec
+{
+   struct _XscTopicFileRec* next;
+   String                   filename;
+   String                   directory;
+   String                   base;       /* Name within the directory */
+   int                      watch;      /* inotify watch of the directory */
+   Boolean                  pending;    /* Changed since it was loaded? */
+   XrmQuark*                names;
+   Cardinal                 count;
+}
+XscTopicFileRec, *XscTopicFile;
+
+/*-------------------------------------------------------------------------
+-- A topic known to a table: either loaded from a topic file, or referred
+-- to by help text (or both).  The references are what a reload uses to
+-- find the widgets to update.
+-------------------------------------------------------------------------*/
+typedef struct _XscTopicRec
+{
+   struct _XscTopicRec* next;
+   XrmQuark             name;
+   String               text;           /* NULL if not loaded from a file */
+   Cardinal             length;
+   XscTopicFile         file;           /* Which file defined it last */
+   unsigned long        stamp;          /* During which load */
+   XtPointer*           references;
+   Cardinal             referenceCount;
+   Cardinal             referenceSize;
+}
+XscTopicRec, *XscTopic;
+
+/*-------------------------------------------------------------------------
+-- A compiled catalog mapped into memory (see TopicP.h for the layout)
+-------------------------------------------------------------------------*/
+typedef struct _XscTopicCatalogRec
+{
+   struct _XscTopicCatalogRec* next;
+   const unsigned char*        map;
+   size_t                      size;
+   Cardinal                    count;
+}
+XscTopicCatalogRec, *XscTopicCatalog;
+
+/*-------------------------------------------------------------------------
+-- The topics of a display, hashed by the quark of their name.  Quarks
+-- are handed out sequentially, so the low bits spread them well.  Topics
+-- that are not in the table are looked for in the catalogs, the most
+-- recently loaded first.
+-------------------------------------------------------------------------*/
+typedef struct _XscTopicTableRec
+{
+   XscTopic*           buckets;
+   Cardinal            size;      /* Always a power of two */
+   Cardinal            count;
+   XscTopicCatalog     catalogs;
+   XscTopicFile        files;
+   XscTopicFile        loading;   /* File being loaded */
+   unsigned long       stamp;     /* Counts the loads */
+   XrmQuark*           names;     /* Topics found by the current load */
+   Cardinal            nameCount;
+   Cardinal            nameSize;
+   XrmQuark*           changed;   /* Topics changed by the current loads */
+   Cardinal            changedCount;
+   Cardinal            changedSize;
+   int                 watchFd;   /* inotify instance, or -1 */
+   XtInputId           watchInput;
+   XscTopicChangedProc changedProc;
+   XtPointer           changedData;
+}
+XscTopicTableRec;
+
+
+/*==============================================================================
+                               Private prototypes
+==============================================================================*/
+static void          _addName      ( XrmQuark**, Cardinal*, Cardinal*, 
+                                     XrmQuark );
+static XscTopicTable _create       ( void );
+static void          _discard      ( XscTopicTable, XscTopic );
+static XscTopic      _enter        ( XscTopicTable, XrmQuark );
+static String        _findInCatalog( XscTopicCatalog, const char* );
+static unsigned long _get32        ( const unsigned char* );
+static void          _grow         ( XscTopicTable );
+static int           _loadFile     ( XscTopicTable, XscTopicFile );
+static XscTopic      _lookup       ( XscTopicTable, XrmQuark );
+static int           _mapFile      ( const char*, char**, size_t*, Boolean* );
+static void          _parse        ( const char*, size_t, XscTopicProc, 
+                                     XtPointer );
+static void          _putTopic     ( XtPointer, String, const char*, Cardinal );
+static int           _readFile     ( int, char**, size_t* );
+static Boolean       _setText      ( XscTopic, const char*, Cardinal );
+static void          _unmapFile    ( char*, size_t, Boolean );
+static void          _watchFile    ( XscTopicTable, XscTopicFile );
+static void          _watchIH      ( XtPointer, int*, XtInputId* );
+
+
+/*==============================================================================
+                           Static global variables
+==============================================================================*/
+/*-----------------------------------------------------------------------
+-- Topics may be loaded before the library is installed on the display,
+-- so the tables are found through their own context
+-----------------------------------------------------------------------*/
+static XContext _topicContextId;
+
+
+/*==============================================================================
+                               Protected functions
+==============================================================================*/
+
+/*----------------------------------------------------------------------------
+-- This function retrieves the topic table of an X display.  If there is
+-- none yet, one is created when 'create' is set.
+------------------------------------------------------------------------------*/
+XscTopicTable _XscTopicTableDeriveFromDisplay( Display* x_display, Boolean create )
+{
+   XPointer data;
+
+   if (!_topicContextId)
+   {
+      _topicContextId = XUniqueContext();
+   }
+
+   if (XFindContext( x_display, (XID) x_display, _topicContextId, &data ) == 0)
+   {
+      return (XscTopicTable) data;
+   }
+
+   if (!create)
+   {
+      return NULL;
+   }
+
+   data = (XPointer) _create();
+   XSaveContext( x_display, (XID) x_display, _topicContextId, data );
+
+   return (XscTopicTable) data;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function is called when the display is closed.  The table itself
+-- is released by its owner with _XscTopicTableDestroy().
+------------------------------------------------------------------------------*/
+void _XscTopicTableForgetDisplay( Display* x_display )
+{
+   if (_topicContextId)
+   {
+      XDeleteContext( x_display, (XID) x_display, _topicContextId );
+   }
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function releases a table and all of its topics
+------------------------------------------------------------------------------*/
+void _XscTopicTableDestroy( XscTopicTable self )
+{
+   Cardinal i;
+
+   _XscTopicTableUnwatch( self );
+
+   for (i = 0; i < self->size; i++)
+   {
+      XscTopic topic = self->buckets[ i ];
+
+      while (topic)
+      {
+         XscTopic next = topic->next;
+
+         XtFree( topic->text );
+         XtFree( (char*) topic->references );
+         XtFree( (char*) topic );
+         topic = next;
+      }
+   }
+   while (self->files)
+   {
+      XscTopicFile file = self->files;
+
+      self->files = file->next;
+      XtFree( file->filename );
+      XtFree( file->directory );
+      XtFree( (char*) file->names );
+      XtFree( (char*) file );
+   }
+   XtFree( (char*) self->names   );
+   XtFree( (char*) self->changed );
+   while (self->catalogs)
+   {
+      XscTopicCatalog catalog = self->catalogs;
+
+      self->catalogs = catalog->next;
+      munmap( (void*) catalog->map, catalog->size );
+      XtFree( (char*) catalog );
+   }
+   XtFree( (char*) self->buckets );
+   XtFree( (char*) self );
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function returns the text of a topic, or NULL if it is not loaded.
+-- 'mapped' tells if the text is in a catalog, where it stays until the
+-- table is destroyed; the text of a topic file changes when it is reloaded.
+------------------------------------------------------------------------------*/
+String _XscTopicTableGet( XscTopicTable self, XrmQuark name, Boolean* mapped )
+{
+   XscTopic        topic = _lookup( self, name );
+   XscTopicCatalog catalog;
+
+   *mapped = False;
+   if (topic && topic->text)
+   {
+      return topic->text;
+   }
+
+   for (catalog = self->catalogs; catalog; catalog = catalog->next)
+   {
+      String text = _findInCatalog( catalog, XrmQuarkToString( name ) );
+
+      if (text)
+      {
+         *mapped = True;
+         return text;
+      }
+   }
+   return NULL;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function stores a copy of 'length' bytes of text as a topic,
+-- replacing any topic of the same name
+------------------------------------------------------------------------------*/
+void _XscTopicTablePut(
+   XscTopicTable self,
+   XrmQuark      name,
+   const char*   text,
+   Cardinal      length )
+{
+   _setText( _enter( self, name ), text, length );
+}
+
+
+/*----------------------------------------------------------------------------
+-- These functions maintain the reverse index from a topic to the help texts
+-- that refer to it, whether or not the topic is loaded
+------------------------------------------------------------------------------*/
+void _XscTopicTableAddReference( 
+   XscTopicTable self, 
+   XrmQuark      name, 
+   XtPointer     reference )
+{
+   XscTopic topic = _enter( self, name );
+
+   if (topic->referenceCount == topic->referenceSize)
+   {
+      topic->referenceSize = topic->referenceSize ? topic->referenceSize * 2 : 4;
+      topic->references    = (XtPointer*) XtRealloc( 
+         (char*) topic->references, sizeof( XtPointer ) * topic->referenceSize );
+   }
+   topic->references[ topic->referenceCount++ ] = reference;
+}
+
+void _XscTopicTableRemoveReference( 
+   XscTopicTable self, 
+   XrmQuark      name, 
+   XtPointer     reference )
+{
+   XscTopic topic = _lookup( self, name );
+   Cardinal i;
+
+   if (!topic)
+   {
+      return;
+   }
+
+   for (i = 0; i < topic->referenceCount; i++)
+   {
+      if (topic->references[ i ] == reference)
+      {
+         topic->references[ i ] = topic->references[ --topic->referenceCount ];
+         break;
+      }
+   }
+   _discard( self, topic );
+}
+
+XtPointer* _XscTopicTableGetReferences( 
+   XscTopicTable self, 
+   XrmQuark      name, 
+   Cardinal*     count )
+{
+   XscTopic topic = _lookup( self, name );
+
+   *count = topic ? topic->referenceCount : 0;
+   return topic ? topic->references : NULL;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function loads the topics of a topic file into the table
+------------------------------------------------------------------------------*/
+int _XscTopicTableLoadFile( XscTopicTable self, const char* filename )
+{
+   XscTopicFile file;
+   char*        slash;
+   int          result;
+
+   for (file = self->files; file; file = file->next)
+   {
+      if (strcmp( file->filename, filename ) == 0)
+      {
+         self->changedCount = 0;
+         return _loadFile( self, file );
+      }
+   }
+
+   /*-------------------------------------------------------------------
+   -- The file is remembered so it can be watched and reloaded later
+   -------------------------------------------------------------------*/
+   file = XtNew( XscTopicFileRec );
+   file->filename = XtNewString( filename );
+   file->watch    = -1;
+   file->pending  = False;
+   file->names    = NULL;
+   file->count    = 0;
+
+   slash = strrchr( file->filename, '/' );
+   if (slash)
+   {
+      file->base      = slash + 1;
+      file->directory = XtMalloc( slash - file->filename + 2 );
+      memcpy( file->directory, file->filename, slash - file->filename + 1 );
+      file->directory[ slash - file->filename + 1 ] = '\0';
+   }
+   else
+   {
+      file->base      = file->filename;
+      file->directory = XtNewString( "." );
+   }
+
+   self->changedCount = 0;
+   result = _loadFile( self, file );
+   if (result)
+   {
+      XtFree( file->filename );
+      XtFree( file->directory );
+      XtFree( (char*) file );
+      return result;
+   }
+
+   file->next  = self->files;
+   self->files = file;
+   _watchFile( self, file );
+
+   return 0;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function starts watching the topic files loaded into the table, and
+-- any loaded later.  When one of them changes it is loaded again, and 
+-- 'proc' is called with the topics whose text changed.  Watching needs
+-- inotify, so ENOSYS is returned where it is not available.
+------------------------------------------------------------------------------*/
+int _XscTopicTableWatch( 
+   XscTopicTable       self, 
+   XtAppContext        app_context,
+   XscTopicChangedProc proc,
+   XtPointer           data )
+{
+#ifdef __linux__
+   XscTopicFile file;
+
+   self->changedProc = proc;
+   self->changedData = data;
+
+   if (self->watchFd >= 0)
+   {
+      return 0;
+   }
+
+   self->watchFd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+   if (self->watchFd < 0)
+   {
+      return errno;
+   }
+
+   for (file = self->files; file; file = file->next)
+   {
+      _watchFile( self, file );
+   }
+
+   self->watchInput = XtAppAddInput( 
+      app_context, 
+      self->watchFd, 
+      (XtPointer) XtInputReadMask, 
+      _watchIH, 
+      (XtPointer) self );
+
+   return 0;
+#else
+   return ENOSYS;
+#endif
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function stops watching the topic files
+------------------------------------------------------------------------------*/
+void _XscTopicTableUnwatch( XscTopicTable self )
+{
+   XscTopicFile file;
+
+   if (self->watchFd < 0)
+   {
+      return;
+   }
+
+   XtRemoveInput( self->watchInput );
+   close( self->watchFd );
+   self->watchFd = -1;
+
+   for (file = self->files; file; file = file->next)
+   {
+      file->watch   = -1;
+      file->pending = False;
+   }
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function maps a compiled catalog and adds it to the table.  The
+-- catalog is checked well enough that a lookup cannot read past its end.
+------------------------------------------------------------------------------*/
+int _XscTopicTableLoadCatalog( XscTopicTable self, const char* filename )
+{
+   XscTopicCatalog      catalog;
+   const unsigned char* map;
+   struct stat          st;
+   size_t               size;
+   Cardinal             count;
+   int                  fd;
+
+   fd = open( filename, O_RDONLY );
+   if (fd < 0)
+   {
+      return errno;
+   }
+
+   if (fstat( fd, &st ) < 0)
+   {
+      int result = errno;
+
+      close( fd );
+      return result;
+   }
+
+   size = (size_t) st.st_size;
+   if (!S_ISREG( st.st_mode ) || (size < XscTopicCatalogHeaderSize))
+   {
+      close( fd );
+      return EINVAL;
+   }
+
+   /*---------------------------------------------------------------
+   -- The mapping is shared, so every application using a catalog
+   -- uses the same pages of the page cache
+   ---------------------------------------------------------------*/
+   map = (const unsigned char*) mmap( 
+      NULL, size, PROT_READ, MAP_SHARED, fd, 0 );
+   close( fd );
+
+   if (map == (const unsigned char*) MAP_FAILED)
+   {
+      return errno;
+   }
+
+   count = _get32( map + XscTopicCatalogCountOffset );
+   if ((memcmp( map, XscTopicCatalogMagic, XscTopicCatalogMagicSize ) != 0) ||
+       (_get32( map + XscTopicCatalogSizeOffset ) != size) ||
+       (count > (size - XscTopicCatalogHeaderSize) / XscTopicCatalogEntrySize) ||
+       (map[ size - 1 ] != '\0'))
+   {
+      munmap( (void*) map, size );
+      return EINVAL;
+   }
+
+   catalog = XtNew( XscTopicCatalogRec );
+   catalog->map   = map;
+   catalog->size  = size;
+   catalog->count = count;
+   catalog->next  = self->catalogs;
+   self->catalogs = catalog;
+
+   return 0;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function calls 'proc' for each topic in a topic file.  There is a
+-- very simple parsing rule: a line starting with ".TEXT[name]" begins the 
+-- topic "name" and a line starting with ".END" (or the next ".TEXT[") ends
+-- it.  The file is mapped into memory and the text passed to 'proc' is only
+-- valid during the call.
+------------------------------------------------------------------------------*/
+int _XscTopicFileParse( const char* filename, XscTopicProc proc, XtPointer data )
+{
+   char*   buffer;
+   size_t  size;
+   Boolean mapped;
+   int     result;
+
+   result = _mapFile( filename, &buffer, &size, &mapped );
+   if (result == 0)
+   {
+      _parse( buffer, size, proc, data );
+      _unmapFile( buffer, size, mapped );
+   }
+   return result;
+}
+
+
+/*==============================================================================
+                               Private functions
+==============================================================================*/
+
+/*----------------------------------------------------------------------------
+-- This function appends a name to a growing list of names
+------------------------------------------------------------------------------*/
+static void _addName( 
+   XrmQuark** names, 
+   Cardinal*  count, 
+   Cardinal*  size, 
+   XrmQuark   name )
+{
+   if (*count == *size)
+   {
+      *size  = *size ? *size * 2 : 64;
+      *names = (XrmQuark*) XtRealloc( 
+         (char*) *names, sizeof( XrmQuark ) * *size );
+   }
+   (*names)[ (*count)++ ] = name;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function creates an empty table
+------------------------------------------------------------------------------*/
+static XscTopicTable _create( void )
+{
+   XscTopicTable self = XtNew( XscTopicTableRec );
+
+   memset( (char*) self, '\0', sizeof( *self ) );
+   self->size    = XscTopicTableInitialSize;
+   self->buckets = (XscTopic*) XtCalloc( self->size, sizeof( XscTopic ) );
+   self->watchFd = -1;
+
+   return self;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function removes a topic that has neither text nor references
+------------------------------------------------------------------------------*/
+static void _discard( XscTopicTable self, XscTopic topic )
+{
+   XscTopic* link;
+
+   if (topic->text || topic->referenceCount)
+   {
+      return;
+   }
+
+   for (link = &self->buckets[ topic->name & (self->size - 1) ];
+        *link != topic;
+        link = &((*link)->next))
+   {
+   }
+   *link = topic->next;
+   self->count -= 1;
+
+   XtFree( (char*) topic->references );
+   XtFree( (char*) topic );
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function returns the entry of a topic, adding it if needed
+------------------------------------------------------------------------------*/
+static XscTopic _enter( XscTopicTable self, XrmQuark name )
+{
+   XscTopic topic = _lookup( self, name );
+   Cardinal index;
+
+   if (topic)
+   {
+      return topic;
+   }
+
+   topic = XtNew( XscTopicRec );
+   memset( (char*) topic, '\0', sizeof( *topic ) );
+   topic->name = name;
+
+   index = name & (self->size - 1);
+   topic->next = self->buckets[ index ];
+   self->buckets[ index ] = topic;
+
+   self->count += 1;
+   if (self->count > self->size)
+   {
+      _grow( self );
+   }
+   return topic;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function looks a topic up in a catalog by binary search
+------------------------------------------------------------------------------*/
+static String _findInCatalog( XscTopicCatalog self, const char* name )
+{
+   const unsigned char* index = self->map + XscTopicCatalogHeaderSize;
+   Cardinal             low   = 0;
+   Cardinal             high  = self->count;
+
+   while (low < high)
+   {
+      Cardinal             middle = low + (high - low) / 2;
+      const unsigned char* entry  = index + middle * XscTopicCatalogEntrySize;
+      unsigned long        offset = _get32( entry );
+      int                  order;
+
+      if (offset >= self->size)
+      {
+         return NULL;
+      }
+
+      order = strcmp( name, (const char*) self->map + offset );
+      if (order == 0)
+      {
+         offset = _get32( entry + 4 );
+         return (offset < self->size) ? (String) self->map + offset : NULL;
+      }
+      if (order < 0)
+      {
+         high = middle;
+      }
+      else
+      {
+         low = middle + 1;
+      }
+   }
+   return NULL;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function reads a catalog number
+------------------------------------------------------------------------------*/
+static unsigned long _get32( const unsigned char* p )
+{
+   return ((unsigned long) p[ 0 ] << 24) | ((unsigned long) p[ 1 ] << 16) |
+          ((unsigned long) p[ 2 ] <<  8) |  (unsigned long) p[ 3 ];
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function doubles the number of buckets
+------------------------------------------------------------------------------*/
+static void _grow( XscTopicTable self )
+{
+   Cardinal  size    = self->size * 2;
+   XscTopic* buckets = (XscTopic*) XtCalloc( size, sizeof( XscTopic ) );
+   Cardinal  i;
+
+   for (i = 0; i < self->size; i++)
+   {
+      XscTopic topic = self->buckets[ i ];
+
+      while (topic)
+      {
+         XscTopic next = topic->next;
+         Cardinal index = topic->name & (size - 1);
+
+         topic->next      = buckets[ index ];
+         buckets[ index ] = topic;
+         topic = next;
+      }
+   }
+   XtFree( (char*) self->buckets );
+   self->buckets = buckets;
+   self->size    = size;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function (re)loads a topic file.  The topics whose text changes are
+-- added to the table's list of changed topics.  Topics the file defined
+-- before, but no longer does, are dropped.
+------------------------------------------------------------------------------*/
+static int _loadFile( XscTopicTable self, XscTopicFile file )
+{
+   Cardinal i;
+   int      result;
+
+   self->loading   = file;
+   self->stamp    += 1;
+   self->nameCount = 0;
+
+   result = _XscTopicFileParse( file->filename, _putTopic, (XtPointer) self );
+   self->loading = NULL;
+
+   if (result)
+   {
+      return result;
+   }
+
+   for (i = 0; i < file->count; i++)
+   {
+      XscTopic topic = _lookup( self, file->names[ i ] );
+
+      if (topic && (topic->file == file) && (topic->stamp != self->stamp))
+      {
+         XtFree( topic->text );
+         topic->text   = NULL;
+         topic->length = 0;
+         topic->file   = NULL;
+
+         _addName( 
+            &self->changed, &self->changedCount, &self->changedSize, 
+            topic->name );
+         _discard( self, topic );
+      }
+   }
+
+   /*------------------------------------------------------------------
+   -- The names found by this load become the file's names
+   ------------------------------------------------------------------*/
+   file->names = (XrmQuark*) XtRealloc( 
+      (char*) file->names, sizeof( XrmQuark ) * self->nameCount );
+   file->count = self->nameCount;
+   if (file->count)
+   {
+      memcpy( file->names, self->names, sizeof( XrmQuark ) * file->count );
+   }
+
+   return 0;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function looks a topic up in the table
+------------------------------------------------------------------------------*/
+static XscTopic _lookup( XscTopicTable self, XrmQuark name )
+{
+   XscTopic topic = self->buckets[ name & (self->size - 1) ];
+
+   while (topic && (topic->name != name))
+   {
+      topic = topic->next;
+   }
+   return topic;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function brings a whole topic file into memory.  Anything that
+-- cannot be mapped (a pipe, say) is read instead.
+------------------------------------------------------------------------------*/
+static int _mapFile( 
+   const char* filename, 
+   char**      buffer, 
+   size_t*     size, 
+   Boolean*    mapped )
+{
+   struct stat st;
+   int         result = 0;
+   int         fd;
+
+   *buffer = NULL;
+   *size   = 0;
+   *mapped = False;
+
+   fd = open( filename, O_RDONLY );
+   if (fd < 0)
+   {
+      return errno;
+   }
+
+   if (fstat( fd, &st ) < 0)
+   {
+      result = errno;
+      close( fd );
+      return result;
+   }
+
+   if (S_ISREG( st.st_mode ) && (st.st_size > 0))
+   {
+      char* map = (char*) mmap( 
+         NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+      if (map != (char*) MAP_FAILED)
+      {
+         *buffer = map;
+         *size   = (size_t) st.st_size;
+         *mapped = True;
+      }
+   }
+
+   if (!*mapped)
+   {
+      result = _readFile( fd, buffer, size );
+   }
+   close( fd );
+
+   return result;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function finds the topics in a topic file image.  Lines are found 
+-- with memchr(), and only lines that start with a '.' are looked at any
+-- further, so the text of a topic is passed on without being copied.
+------------------------------------------------------------------------------*/
+static void _parse( 
+   const char*  buffer, 
+   size_t       size, 
+   XscTopicProc proc, 
+   XtPointer    data )
+{
+   char*       name     = NULL;
+   size_t      nameSize = 0;
+   const char* end      = buffer + size;
+   const char* line     = buffer;
+   const char* topic    = NULL;    /* Where the current topic text starts */
+
+   while (line < end)
+   {
+      const char* next = (const char*) memchr( line, '\n', end - line );
+      size_t      length;
+      Boolean     isText;
+
+      next   = next ? next + 1 : end;
+      length = next - line;
+
+      if (*line != '.')
+      {
+         line = next;
+         continue;
+      }
+
+      isText = (length >= 6) && (strncmp( line, ".TEXT[", 6 ) == 0);
+      if (!isText && ((length < 4) || (strncmp( line, ".END", 4 ) != 0)))
+      {
+         line = next;
+         continue;
+      }
+
+      /*------------------------------------------------------------
+      -- Either marker ends the current topic.  The text runs up to
+      -- the start of this line, less its final newline.
+      ------------------------------------------------------------*/
+      if (topic && *name)
+      {
+         (*proc)( 
+            data, 
+            name, 
+            topic, 
+            (line > topic) ? (Cardinal) (line - topic - 1) : 0 );
+      }
+      topic = NULL;
+
+      if (isText)
+      {
+         const char* start = line + 6;
+         const char* stop;
+
+         /*----------------------------------------------------------
+         -- The name is what is between the brackets, without any
+         -- surrounding white space.  The ']' may be left out.
+         ----------------------------------------------------------*/
+         while ((start < next) && isspace( (unsigned char) *start ))
+         {
+            start++;
+         }
+         stop = start;
+         while ((stop < next) && (*stop != ']'))
+         {
+            stop++;
+         }
+         while ((stop > start) && isspace( (unsigned char) stop[ -1 ] ))
+         {
+            stop--;
+         }
+
+         if (nameSize < (size_t) (stop - start) + 1)
+         {
+            nameSize = (stop - start) + 1;
+            name     = XtRealloc( name, nameSize );
+         }
+         memcpy( name, start, stop - start );
+         name[ stop - start ] = '\0';
+
+         topic = next;
+      }
+      line = next;
+   }
+   XtFree( name );
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function stores a topic found in a topic file into a table
+------------------------------------------------------------------------------*/
+static void _putTopic( 
+   XtPointer   cd, 
+   String      name, 
+   const char* text, 
+   Cardinal    length )
+{
+   XscTopicTable self  = (XscTopicTable) cd;
+   XscTopic      topic = _enter( self, XrmStringToQuark( name ) );
+
+   if (_setText( topic, text, length ))
+   {
+      _addName( 
+         &self->changed, &self->changedCount, &self->changedSize, 
+         topic->name );
+   }
+   topic->file  = self->loading;
+   topic->stamp = self->stamp;
+
+   _addName( &self->names, &self->nameCount, &self->nameSize, topic->name );
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function reads a topic file that could not be mapped into memory
+------------------------------------------------------------------------------*/
+static int _readFile( int fd, char** buffer, size_t* size )
+{
+   size_t allocated = 64 * 1024;
+   size_t used      = 0;
+   char*  data      = XtMalloc( allocated );
+
+   for (;;)
+   {
+      ssize_t count;
+
+      if (used == allocated)
+      {
+         allocated *= 2;
+         data       = XtRealloc( data, allocated );
+      }
+
+      count = read( fd, data + used, allocated - used );
+      if (count == 0)
+      {
+         break;
+      }
+      if (count < 0)
+      {
+         int result = errno;
+
+         if (result == EINTR)
+         {
+            continue;
+         }
+         XtFree( data );
+         return result;
+      }
+      used += count;
+   }
+
+   *buffer = data;
+   *size   = used;
+   return 0;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function replaces the text of a topic, if it is different
+------------------------------------------------------------------------------*/
+static Boolean _setText( XscTopic self, const char* text, Cardinal length )
+{
+   if (self->text && (self->length == length) && 
+       (memcmp( self->text, text, length ) == 0))
+   {
+      return False;
+   }
+
+   XtFree( self->text );
+   self->text   = XtMalloc( length + 1 );
+   self->length = length;
+   memcpy( self->text, text, length );
+   self->text[ length ] = '\0';
+
+   return True;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function releases what _mapFile() returned
+------------------------------------------------------------------------------*/
+static void _unmapFile( char* buffer, size_t size, Boolean mapped )
+{
+   if (mapped)
+   {
+      munmap( (void*) buffer, size );
+   }
+   else
+   {
+      XtFree( buffer );
+   }
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function watches the directory of a topic file, if the table is
+-- being watched.  Watching the directory rather than the file also sees
+-- a file replaced by rename, as editors and installers do.
+------------------------------------------------------------------------------*/
+static void _watchFile( XscTopicTable self, XscTopicFile file )
+{
+#ifdef __linux__
+   if ((self->watchFd >= 0) && (file->watch < 0))
+   {
+      file->watch = inotify_add_watch( 
+         self->watchFd, file->directory, IN_CLOSE_WRITE | IN_MOVED_TO );
+   }
+#endif
+}
+
+
+/*----------------------------------------------------------------------------
+-- This input handler reloads the topic files that changed and reports the
+-- topics that changed with them
+------------------------------------------------------------------------------*/
+static void _watchIH( XtPointer cd, int* fd, XtInputId* id )
+{
+#ifdef __linux__
+   XscTopicTable self = (XscTopicTable) cd;
+   XscTopicFile  file;
+   union
+   {
+      struct inotify_event event;
+      char                 data[ 4096 ];
+   }
+   buffer;
+   ssize_t count;
+
+   while ((count = read( *fd, buffer.data, sizeof( buffer ) )) > 0)
+   {
+      char* p = buffer.data;
+
+      while (p < buffer.data + count)
+      {
+         struct inotify_event* event = (struct inotify_event*) p;
+
+         for (file = self->files; file; file = file->next)
+         {
+            if ((file->watch == event->wd) && event->len &&
+                (strcmp( file->base, event->name ) == 0))
+            {
+               file->pending = True;
+            }
+         }
+         p += sizeof( struct inotify_event ) + event->len;
+      }
+   }
+
+   /*-------------------------------------------------------------
+   -- A file that cannot be read right now keeps its old topics
+   -------------------------------------------------------------*/
+   self->changedCount = 0;
+   for (file = self->files; file; file = file->next)
+   {
+      if (file->pending)
+      {
+         file->pending = False;
+         _loadFile( self, file );
+      }
+   }
+
+   if (self->changedCount && self->changedProc)
+   {
+      (*self->changedProc)( 
+         self->changedData, self->changed, self->changedCount );
+   }
+#endif
+}
@@ -0,0 +1,107 @@
+/*------------------------------------------------------------------------------
+--  Help ToolKit for Motif
+--
+--  (c) Copyright 1997-1999, 2019 Robert S. Werner (a.k.a. Akiva Werner)
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+------------------------------------------------------------------------------*/
+
+#ifndef __XscTopicP_h
+#define __XscTopicP_h
+
+
+#include <X11/Intrinsic.h>
+
+
+/*==============================================================================
+                                   Handle
+==============================================================================*/
+typedef struct _XscTopicTableRec *XscTopicTable;
+
+
+/*==============================================================================
+                              Private Includes
+==============================================================================*/
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+                                    Macros
+==============================================================================*/
+/*---------------------------------------------------------------------
+-- The number of hash buckets a topic table starts out with
+---------------------------------------------------------------------*/
+#define XscTopicTableInitialSize 256
+
+/*---------------------------------------------------------------------
+-- A compiled topic catalog starts with a header:
+--
+--    magic   8 bytes   XscTopicCatalogMagic
+--    count   4 bytes   Number of topics
+--    size    4 bytes   Size of the whole file
+--
+-- followed by 'count' index entries sorted by name (as by strcmp()):
+--
+--    name    4 bytes   File offset of the topic name
+--    text    4 bytes   File offset of the topic text
+--
+-- followed by the names and texts, each terminated by a '\0'.  All
+-- numbers are unsigned, most significant byte first.
+---------------------------------------------------------------------*/
+#define XscTopicCatalogMagic       "XscTopc1"
+#define XscTopicCatalogMagicSize   8
+#define XscTopicCatalogCountOffset 8
+#define XscTopicCatalogSizeOffset  12
+#define XscTopicCatalogHeaderSize  16
+#define XscTopicCatalogEntrySize   8
+
+
+/*==============================================================================
+                               Data types
+==============================================================================*/
+/*---------------------------------------------------------------------
+-- Called for each topic of a topic file.  The text is 'length' bytes
+-- long and is not terminated.
+---------------------------------------------------------------------*/
+typedef void (*XscTopicProc)( XtPointer, String, const char*, Cardinal );
+
+/*---------------------------------------------------------------------
+-- Called with the topics a reload of watched topic files changed
+---------------------------------------------------------------------*/
+typedef void (*XscTopicChangedProc)( XtPointer, XrmQuark*, Cardinal );
+
+
+/*==============================================================================
+                                  Prototypes
+==============================================================================*/
+XscTopicTable _XscTopicTableDeriveFromDisplay( Display*, Boolean );
+void          _XscTopicTableForgetDisplay    ( Display* );
+
+void _XscTopicTableDestroy( XscTopicTable );
+
+String _XscTopicTableGet( XscTopicTable, XrmQuark, Boolean* );
+void   _XscTopicTablePut( XscTopicTable, XrmQuark, const char*, Cardinal );
+
+void       _XscTopicTableAddReference   ( XscTopicTable, XrmQuark, XtPointer );
+XtPointer* _XscTopicTableGetReferences  ( XscTopicTable, XrmQuark, Cardinal* );
+void       _XscTopicTableRemoveReference( XscTopicTable, XrmQuark, XtPointer );
+
+int _XscTopicTableLoadCatalog( XscTopicTable, const char* );
+int _XscTopicTableLoadFile   ( XscTopicTable, const char* );
+
+int  _XscTopicTableWatch  ( XscTopicTable, XtAppContext, XscTopicChangedProc,
+                            XtPointer );
+void _XscTopicTableUnwatch( XscTopicTable );
+
+int _XscTopicFileParse( const char*, XscTopicProc, XtPointer );
+
+
+#ifdef __cplusplus
+}  /* Close scope of 'extern "C"' declaration which encloses file. */
+#endif
+
+#endif
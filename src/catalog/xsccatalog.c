@@ -0,0 +1,228 @@
+/*------------------------------------------------------------------------------
+--  Help ToolKit for Motif topic catalog compiler
+--
+--  (c) Copyright 1997-1999, 2019 Robert S. Werner (a.k.a. Akiva Werner)
+--  ALL RIGHTS RESERVED
+--
+--  License: The MIT License (MIT)
+--
+--  Usage: xsccatalog -o catalog topic-file...
+--
+--  The topic files are read as XscHelpLoadTopics() reads them.  When a topic
+--  is defined more than once, the last definition is kept.  The catalog can
+--  be loaded with XscHelpLoadTopicCatalog().
+------------------------------------------------------------------------------*/
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <X11/Intrinsic.h>
+
+#include "TopicP.h"
+
+/*==============================================================================
+                               Private data types
+==============================================================================*/
+typedef struct _TopicRec
+{
+   char*    name;
+   char*    text;
+   Cardinal length;
+   Cardinal sequence;   /* Order of definition, to keep the last one */
+}
+TopicRec;
+
+typedef struct _TopicListRec
+{
+   TopicRec* topics;
+   Cardinal  count;
+   Cardinal  size;
+}
+TopicListRec;
+
+
+/*==============================================================================
+                               Private functions
+==============================================================================*/
+
+/*----------------------------------------------------------------------------
+-- This function collects a topic found in a topic file
+------------------------------------------------------------------------------*/
+static void addTopic( XtPointer cd, String name, const char* text, Cardinal length )
+{
+   TopicListRec* list = (TopicListRec*) cd;
+   TopicRec*     topic;
+
+   if (list->count == list->size)
+   {
+      list->size   = list->size ? list->size * 2 : 1024;
+      list->topics = (TopicRec*) XtRealloc(
+         (char*) list->topics, sizeof( TopicRec ) * list->size );
+   }
+
+   topic = &list->topics[ list->count ];
+   topic->name     = XtNewString( name );
+   topic->text     = XtMalloc( length + 1 );
+   topic->length   = length;
+   topic->sequence = list->count;
+   memcpy( topic->text, text, length );
+   topic->text[ length ] = '\0';
+
+   list->count += 1;
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function orders topics by name, and then by when they were defined
+------------------------------------------------------------------------------*/
+static int compareTopics( const void* a, const void* b )
+{
+   const TopicRec* ta    = (const TopicRec*) a;
+   const TopicRec* tb    = (const TopicRec*) b;
+   int             order = strcmp( ta->name, tb->name );
+
+   if (order == 0)
+   {
+      order = (ta->sequence < tb->sequence) ? -1 : 1;
+   }
+   return order;
+}
+
+
+static void put32( FILE* file, unsigned long value )
+{
+   putc( (int) ((value >> 24) & 0xff), file );
+   putc( (int) ((value >> 16) & 0xff), file );
+   putc( (int) ((value >>  8) & 0xff), file );
+   putc( (int) ( value        & 0xff), file );
+}
+
+
+/*----------------------------------------------------------------------------
+-- This function writes the catalog.  It is written to a temporary file that
+-- then replaces the catalog, since running applications may have the old
+-- one mapped and must not see it change under them.
+------------------------------------------------------------------------------*/
+static int writeCatalog( const char* filename, TopicListRec* list )
+{
+   char*         temporary;
+   FILE*         file;
+   Cardinal      count;
+   Cardinal      i, j;
+   unsigned long offset;
+   unsigned long size;
+
+   /*---------------------------------------------------
+   -- Sort the topics and drop all but the last of the
+   -- topics defined more than once
+   ---------------------------------------------------*/
+   qsort( list->topics, list->count, sizeof( TopicRec ), compareTopics );
+
+   count = 0;
+   for (i = 0; i < list->count; i = j)
+   {
+      for (j = i + 1;
+           (j < list->count) &&
+              (strcmp( list->topics[ i ].name, list->topics[ j ].name ) == 0);
+           j++)
+      {
+      }
+      list->topics[ count++ ] = list->topics[ j - 1 ];
+   }
+
+   size = XscTopicCatalogHeaderSize + count * XscTopicCatalogEntrySize;
+   for (i = 0; i < count; i++)
+   {
+      size += strlen( list->topics[ i ].name ) + 1;
+      size += list->topics[ i ].length + 1;
+
+      if (size > 0xffffffffUL)
+      {
+         fprintf( stderr, "xsccatalog: the topics do not fit in a catalog\n" );
+         return 0;
+      }
+   }
+
+   temporary = XtMalloc( strlen( filename ) + 5 );
+   sprintf( temporary, "%s.new", filename );
+
+   file = fopen( temporary, "wb" );
+   if (!file)
+   {
+      fprintf( stderr, "xsccatalog: %s: %s\n", temporary, strerror( errno ) );
+      XtFree( temporary );
+      return 0;
+   }
+
+   fwrite( XscTopicCatalogMagic, 1, XscTopicCatalogMagicSize, file );
+   put32( file, count );
+   put32( file, size );
+
+   offset = XscTopicCatalogHeaderSize + count * XscTopicCatalogEntrySize;
+   for (i = 0; i < count; i++)
+   {
+      put32( file, offset );
+      offset += strlen( list->topics[ i ].name ) + 1;
+
+      put32( file, offset );
+      offset += list->topics[ i ].length + 1;
+   }
+
+   for (i = 0; i < count; i++)
+   {
+      fwrite( list->topics[ i ].name, 1, strlen( list->topics[ i ].name ) + 1,
+              file );
+      fwrite( list->topics[ i ].text, 1, list->topics[ i ].length + 1, file );
+   }
+
+   if ((fclose( file ) != 0) || (rename( temporary, filename ) != 0))
+   {
+      fprintf( stderr, "xsccatalog: %s: %s\n", filename, strerror( errno ) );
+      remove( temporary );
+      XtFree( temporary );
+      return 0;
+   }
+
+   XtFree( temporary );
+   return 1;
+}
+
+
+int main( int argc, char** argv )
+{
+   TopicListRec list;
+   const char*  output = NULL;
+   int          i;
+
+   list.topics = NULL;
+   list.count  = 0;
+   list.size   = 0;
+
+   for (i = 1; i < argc; i++)
+   {
+      if ((strcmp( argv[ i ], "-o" ) == 0) && (i + 1 < argc))
+      {
+         output = argv[ ++i ];
+      }
+      else
+      {
+         int result = _XscTopicFileParse( argv[ i ], addTopic, (XtPointer) &list );
+
+         if (result)
+         {
+            fprintf( stderr, "xsccatalog: %s: %s\n", argv[ i ], strerror( result ) );
+            return 1;
+         }
+      }
+   }
+
+   if (!output)
+   {
+      fprintf( stderr, "usage: xsccatalog -o catalog topic-file...\n" );
+      return 2;
+   }
+
+   return writeCatalog( output, &list ) ? 0 : 1;
+}